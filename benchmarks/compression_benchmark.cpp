@@ -0,0 +1,99 @@
+// Compares the memory taken by Digraph, CSRDigraph and CompressedDigraph on unweighted graphs, and the time of a full
+// breadth first search on each, once with the randomly permuted ids of the generators and once after a BFS relabelling.
+// usage: compression_benchmark [grid side] [rmat scale]
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "compressed_digraph.h"
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "reordering/node_order.h"
+
+using Graph = CSRDigraph<Edge>;
+
+constexpr unsigned repetitions = 3;
+
+// list nodes hold the edge and two pointers, the arena adds no per allocation overhead
+size_t digraph_bytes(Graph const & G)
+{
+    return G.num_edges() * (sizeof(Edge) + 2 * sizeof(void *)) + G.num_nodes() * sizeof(Node<Edge>);
+}
+
+size_t csr_bytes(Graph const & G)
+{
+    return G.offset_array().size_bytes() + G.target_array().size_bytes() + G.name_array().size_bytes();
+}
+
+template<IsDigraph graph_type>
+void report(const char * name, graph_type const & G, size_t bytes, std::vector<int> const & expected, double & base_time)
+{
+    std::vector<int> order;
+    const double time = best_time(repetitions, [&] { order = compute_node_order(G, NodeOrder::bfs); });
+    if (order != expected) {
+        report_failure() << name << " visits the nodes in another order" << std::endl;
+    }
+    if (base_time == 0) {
+        base_time = time;
+    }
+    std::printf("  %-22s %12zu %10.2f %10.3f %9.2fx\n", name, bytes, static_cast<double>(bytes) / G.num_edges(), time, time / base_time);
+}
+
+void benchmark(std::string const & title, Graph const & G)
+{
+    std::cout << title << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges" << std::endl;
+    std::printf("  %-22s %12s %10s %10s %10s\n", "representation", "bytes", "bytes/edge", "bfs [s]", "time/csr");
+    // CompressedDigraph sorts the neighbour lists, so the CSR graph used for comparison does as well
+    std::vector<Edge> edges;
+    edges.reserve(G.num_edges());
+    for (int i = 0; i < G.num_nodes(); i++) {
+        for (auto const & edge : G.adjList(i)) {
+            edges.push_back(edge);
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](Edge const & a, Edge const & b) { return a.from != b.from ? a.from < b.from : a.to < b.to; });
+    const Graph sorted(G.num_nodes(), edges);
+    const std::vector<int> expected = compute_node_order(sorted, NodeOrder::bfs);
+
+    double base_time = 0;
+    std::printf("  %-22s %12zu %10.2f\n", "Digraph (estimated)", digraph_bytes(sorted), static_cast<double>(digraph_bytes(sorted)) / G.num_edges());
+    report("CSRDigraph", sorted, csr_bytes(sorted), expected, base_time);
+    const CompressedDigraph<> varint(sorted, GapEncoding::varint);
+    report("Compressed varint", varint, varint.memory_bytes(), expected, base_time);
+    const CompressedDigraph<> group(sorted, GapEncoding::group_varint);
+    report("Compressed group varint", group, group.memory_bytes(), expected, base_time);
+    const CompressedDigraph<int, uint32_t> small_offsets(sorted, GapEncoding::varint);
+    report("  with 32 bit offsets", small_offsets, small_offsets.memory_bytes(), expected, base_time);
+    std::cout << std::endl;
+}
+
+template<typename weight_type>
+Graph unweighted(EdgeListFile<weight_type> const & file)
+{
+    std::vector<Edge> edges;
+    edges.reserve(file.edges.size());
+    for (auto const & edge : file.edges) {
+        edges.emplace_back(edge.from, edge.to);
+    }
+    return Graph(file.num_nodes, edges);
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 20;
+    const Graph grid = unweighted(grid_graph<int>(side, side, 1, 1));
+    const Graph rmat = unweighted(rmat_graph<int>(scale, 16, 1, 2));
+    const std::string grid_title = "grid " + std::to_string(side) + "x" + std::to_string(side);
+    const std::string rmat_title = "rmat scale " + std::to_string(scale);
+    benchmark(grid_title + ", random ids", grid);
+    benchmark(grid_title + ", bfs order", relabel(grid, compute_node_order(grid, NodeOrder::bfs)));
+    benchmark(rmat_title + ", random ids", rmat);
+    benchmark(rmat_title + ", bfs order", relabel(rmat, compute_node_order(rmat, NodeOrder::bfs)));
+    return benchmark_status();
+}
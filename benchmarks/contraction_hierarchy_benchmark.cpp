@@ -0,0 +1,117 @@
+// Builds a contraction hierarchy of a road-like grid and reports its preprocessing time and memory, then compares the
+// latency of its queries with dijkstra and bidirectional dijkstra. Every distance is checked against dijkstra, and every
+// unpacked path is checked to consist of edges of the graph that add up to that distance.
+// usage: contraction_hierarchy_benchmark [grid side] [queries] [witness limit]
+// Author: Georgi Kocharyan
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "graph_io/edge_list_reader.h"
+#include "shortest_paths/bidirectional_dijkstra.h"
+#include "shortest_paths/contraction_hierarchy.h"
+#include "shortest_paths/dijkstra.h"
+
+using Graph = Digraph<WeightedEdge<double>>;
+
+// the weight of the path, or a negative value if two consecutive nodes are not joined by an edge
+double path_weight(Graph const & G, std::vector<int> const & path)
+{
+    double weight = 0;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+        double lightest = std::numeric_limits<double>::max();
+        for (const auto & edge : G.adjList(path[i])) {
+            if (edge.to == path[i + 1]) {
+                lightest = std::min(lightest, edge.weight);
+            }
+        }
+        if (lightest == std::numeric_limits<double>::max()) {
+            return -1;
+        }
+        weight += lightest;
+    }
+    return weight;
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 300;
+    const size_t queries = argc > 2 ? std::stoul(argv[2]) : 1000;
+    const size_t witness_limit = argc > 3 ? std::stoul(argv[3]) : 500;
+    const Graph G = to_digraph(grid_graph<double>(side, side, 100, 1));
+    std::cout << "grid " << side << "x" << side << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges, " << queries
+        << " queries" << std::endl;
+
+    std::unique_ptr<ContractionHierarchy<int>> hierarchy;
+    const double preprocessing = best_time(1, [&] { hierarchy = std::make_unique<ContractionHierarchy<int>>(G, witness_limit); });
+    const ContractionHierarchy<int> & CH = *hierarchy;
+    const size_t csr_bytes = (G.num_nodes() + 1) * sizeof(int) + G.num_edges() * (sizeof(int) + sizeof(double));
+    std::printf("  preprocessing %.3f s, %zu shortcuts (%.2f per edge)\n", preprocessing, CH.num_shortcuts(),
+        static_cast<double>(CH.num_shortcuts()) / G.num_edges());
+    std::printf("  hierarchy %zu bytes, %.2fx the graph as CSR\n", CH.memory_bytes(), static_cast<double>(CH.memory_bytes()) / csr_bytes);
+
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<int> node(0, G.num_nodes() - 1);
+    std::vector<std::pair<int, int>> pairs(queries);
+    for (auto & pair : pairs) {
+        pair = {node(rng), node(rng)};
+    }
+    // a full dijkstra per query is slow, so only the first few are timed with it, and the rest are checked against it
+    // without timing
+    const size_t timed_dijkstra = std::min<size_t>(queries, 10);
+    std::vector<double> expected(queries);
+    std::vector<double> min_distances;
+    std::vector<int> predecessor;
+    auto run_dijkstra = [&](size_t q) {
+        min_distances.assign(G.num_nodes(), std::numeric_limits<double>::max());
+        predecessor.assign(G.num_nodes(), pairs[q].first);
+        dijkstra(G, min_distances, pairs[q].first, predecessor);
+        expected[q] = min_distances[pairs[q].second];
+    };
+    const double dijkstra_time = best_time(1, [&] {
+        for (size_t q = 0; q < timed_dijkstra; q++) {
+            run_dijkstra(q);
+        }
+    }) / timed_dijkstra;
+    for (size_t q = timed_dijkstra; q < queries; q++) {
+        run_dijkstra(q);
+    }
+
+    std::printf("  %-16s %14s %14s %10s\n", "search", "settled/query", "us/query", "speedup");
+    std::printf("  %-16s %14zu %14.1f %9.1fx\n", "dijkstra", G.num_nodes(), 1e6 * dijkstra_time, 1.0);
+    auto measure = [&](const char * name, auto & search) {
+        search.query(0, 0);
+        size_t settled = 0;
+        std::vector<ShortestPath<int>> results(queries);
+        const double time = best_time(1, [&] {
+            for (size_t q = 0; q < queries; q++) {
+                results[q] = search.query(pairs[q].first, pairs[q].second);
+            }
+        }) / queries;
+        for (size_t q = 0; q < queries; q++) {
+            settled += results[q].settled;
+            if (std::abs(results[q].distance - expected[q]) > 1e-9 * std::abs(expected[q])) {
+                report_failure() << name << " computes another distance for query " << q << std::endl;
+            }
+            else if (!results[q].path.empty() && std::abs(path_weight(G, results[q].path) - expected[q]) > 1e-9 * std::abs(expected[q])) {
+                report_failure() << name << " returns a wrong path for query " << q << std::endl;
+            }
+        }
+        std::printf("  %-16s %14zu %14.1f %9.1fx\n", name, settled / queries, 1e6 * time, dijkstra_time / time);
+    };
+    BidirectionalDijkstra<Graph> bidirectional(G);
+    measure("bidirectional", bidirectional);
+    ContractionHierarchyQuery<int> ch_query(CH);
+    measure("hierarchy", ch_query);
+    return benchmark_status();
+}
@@ -0,0 +1,73 @@
+// Measures delta_stepping for several thread counts and bucket widths against dijkstra, on a road-like grid and on a
+// power-law graph, and checks that the distances agree.
+// usage: delta_stepping_benchmark [grid side] [rmat scale] [max threads]
+// Author: Georgi Kocharyan
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "shortest_paths/delta_stepping.h"
+#include "shortest_paths/dijkstra.h"
+
+using Graph = CSRDigraph<WeightedEdge<double>>;
+
+constexpr unsigned repetitions = 3;
+
+void benchmark(std::string const & title, Graph const & G, unsigned max_threads)
+{
+    std::cout << title << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges" << std::endl;
+    int source = 0;
+    for (int i = 1; i < G.num_nodes(); i++) {
+        if (G.outdeg(i) > G.outdeg(source)) {
+            source = i;
+        }
+    }
+    std::vector<double> expected;
+    std::vector<int> predecessor;
+    const double dijkstra_time = best_time(repetitions, [&] {
+        expected.assign(G.num_nodes(), std::numeric_limits<double>::max());
+        predecessor.assign(G.num_nodes(), source);
+        dijkstra(G, expected, source, predecessor);
+    });
+    std::printf("  dijkstra %.3f s\n", dijkstra_time);
+    std::printf("  %-8s %10s %10s %9s\n", "threads", "delta", "time [s]", "speedup");
+
+    // the default width, as chosen by delta_stepping
+    const double auto_delta = G.get_max() * static_cast<double>(G.num_nodes()) / G.num_edges();
+    for (const double delta : {auto_delta / 4, auto_delta, auto_delta * 4}) {
+        for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+            std::vector<double> min_distances;
+            const double time = best_time(repetitions, [&] {
+                min_distances.assign(G.num_nodes(), std::numeric_limits<double>::max());
+                predecessor.assign(G.num_nodes(), source);
+                delta_stepping(G, min_distances, source, predecessor, delta, threads);
+            });
+            for (size_t i = 0; i < expected.size(); i++) {
+                if (std::abs(min_distances[i] - expected[i]) > 1e-9 * std::abs(expected[i])) {
+                    report_failure() << "delta stepping computes another distance for node " << i << std::endl;
+                    break;
+                }
+            }
+            std::printf("  %-8u %10.2f %10.3f %8.2fx\n", threads, delta, time, dijkstra_time / time);
+        }
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 20;
+    const unsigned max_threads = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    benchmark("grid " + std::to_string(side) + "x" + std::to_string(side), to_csr(grid_graph<double>(side, side, 100, 1)), max_threads);
+    benchmark("rmat scale " + std::to_string(scale), to_csr(rmat_graph<double>(scale, 8, 100, 2)), max_threads);
+    return benchmark_status();
+}
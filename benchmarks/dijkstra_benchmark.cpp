@@ -0,0 +1,163 @@
+// Compares dijkstra on the indexed d-ary heaps of shortest_paths/d_ary_heap.h for several arities with the former
+// implementation, which seeded a std::priority_queue with every node and skipped outdated entries when popping them,
+// on a road-like grid and on a power-law graph. With integral weights dijkstra_radix, dijkstra_dial and dijkstra_auto
+// are compared as well, for a small, a large and a very large range of weights.
+// usage: dijkstra_benchmark [grid side] [rmat scale]
+// Author: Georgi Kocharyan
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "shortest_paths/dijkstra.h"
+#include "shortest_paths/dijkstra_auto.h"
+#include "shortest_paths/dijkstra_dial.h"
+#include "shortest_paths/dijkstra_radix.h"
+
+using Graph = CSRDigraph<WeightedEdge<double>>;
+using IntegralGraph = CSRDigraph<WeightedEdge<int>>;
+
+constexpr unsigned repetitions = 3;
+
+struct Vertex_with_predecessor
+{
+    int id;
+    double dist;
+    int predecessor_id;
+};
+
+// the former dijkstra, kept as the baseline
+void lazy_dijkstra(Graph const & G, std::vector<double> & min_distances, int measuring_from, std::vector<int> & predecessor)
+{
+    std::vector<bool> visited(G.num_nodes(), false);
+    const auto compare = [](Vertex_with_predecessor const & a, Vertex_with_predecessor const & b) { return a.dist > b.dist; };
+    std::priority_queue<Vertex_with_predecessor, std::vector<Vertex_with_predecessor>, decltype(compare)> Q(compare);
+    min_distances[measuring_from] = 0;
+    for (int i = 0; i < G.num_nodes(); i++) {
+        Q.push({i, min_distances[i], i});
+    }
+    while (!Q.empty()) {
+        const Vertex_with_predecessor v = Q.top();
+        Q.pop();
+        if (visited[v.id]) {
+            continue;
+        }
+        visited[v.id] = true;
+        predecessor[v.id] = v.predecessor_id;
+        for (const auto & edge : G.adjList(v.id)) {
+            if (!visited[edge.to] && v.dist + edge.weight < min_distances[edge.to]) {
+                min_distances[edge.to] = v.dist + edge.weight;
+                Q.push({edge.to, min_distances[edge.to], v.id});
+            }
+        }
+    }
+}
+
+template<IsDigraph graph_type, typename function>
+double measure(const char * name, graph_type const & G, int source, std::vector<double> const & expected, function run, double & base_time)
+{
+    std::vector<double> min_distances;
+    std::vector<int> predecessor;
+    const double time = best_time(repetitions, [&] {
+        min_distances.assign(G.num_nodes(), std::numeric_limits<double>::max());
+        predecessor.assign(G.num_nodes(), source);
+        run(min_distances, predecessor);
+    });
+    for (size_t i = 0; i < expected.size(); i++) {
+        if (std::abs(min_distances[i] - expected[i]) > 1e-9 * std::abs(expected[i])) {
+            report_failure() << name << " computes another distance for node " << i << std::endl;
+            break;
+        }
+    }
+    if (base_time == 0) {
+        base_time = time;
+    }
+    std::printf("%-16s %12.3f %8.2fx\n", name, time, base_time / time);
+    return time;
+}
+
+void benchmark(std::string const & title, Graph const & G)
+{
+    std::cout << title << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges" << std::endl;
+    std::printf("%-16s %12s %9s\n", "heap", "dijkstra [s]", "speedup");
+    int source = 0;
+    for (int i = 1; i < G.num_nodes(); i++) {
+        if (G.outdeg(i) > G.outdeg(source)) {
+            source = i;
+        }
+    }
+    std::vector<double> expected(G.num_nodes(), std::numeric_limits<double>::max());
+    std::vector<int> expected_predecessor(G.num_nodes(), source);
+    lazy_dijkstra(G, expected, source, expected_predecessor);
+
+    double base_time = 0;
+    measure("lazy binary", G, source, expected, [&](auto & d, auto & p) { lazy_dijkstra(G, d, source, p); }, base_time);
+    measure("indexed 2-ary", G, source, expected, [&](auto & d, auto & p) { dijkstra<2>(G, d, source, p); }, base_time);
+    measure("indexed 4-ary", G, source, expected, [&](auto & d, auto & p) { dijkstra<4>(G, d, source, p); }, base_time);
+    measure("indexed 8-ary", G, source, expected, [&](auto & d, auto & p) { dijkstra<8>(G, d, source, p); }, base_time);
+    measure("indexed 16-ary", G, source, expected, [&](auto & d, auto & p) { dijkstra<16>(G, d, source, p); }, base_time);
+    std::cout << std::endl;
+}
+
+// runs search with integral distances and copies them to d, where unreachable nodes keep the maximum of double
+template<typename function>
+void with_integral_distances(size_t n, std::vector<double> & d, function search)
+{
+    std::vector<long long> distances(n, std::numeric_limits<long long>::max());
+    search(distances);
+    for (size_t i = 0; i < n; i++) {
+        if (distances[i] != std::numeric_limits<long long>::max()) {
+            d[i] = static_cast<double>(distances[i]);
+        }
+    }
+}
+
+void benchmark_integral(std::string const & title, IntegralGraph const & G)
+{
+    std::cout << title << " with integral weights up to " << G.get_max() << std::endl;
+    std::printf("%-16s %12s %9s\n", "heap", "dijkstra [s]", "speedup");
+    int source = 0;
+    for (int i = 1; i < G.num_nodes(); i++) {
+        if (G.outdeg(i) > G.outdeg(source)) {
+            source = i;
+        }
+    }
+    std::vector<double> expected(G.num_nodes(), std::numeric_limits<double>::max());
+    std::vector<int> expected_predecessor(G.num_nodes(), source);
+    dijkstra(G, expected, source, expected_predecessor);
+
+    double base_time = 0;
+    measure("indexed 4-ary", G, source, expected, [&](auto & d, auto & p) { dijkstra<4>(G, d, source, p); }, base_time);
+    measure("radix", G, source, expected, [&](auto & d, auto & p) {
+        with_integral_distances(G.num_nodes(), d, [&](auto & distances) { dijkstra_radix(G, distances, source, p); });
+    }, base_time);
+    measure("dial", G, source, expected, [&](auto & d, auto & p) {
+        with_integral_distances(G.num_nodes(), d, [&](auto & distances) { dijkstra_dial(G, distances, source, p); });
+    }, base_time);
+    DijkstraQueue chosen{};
+    measure("auto", G, source, expected, [&](auto & d, auto & p) {
+        with_integral_distances(G.num_nodes(), d, [&](auto & distances) { chosen = dijkstra_auto(G, distances, source, p); });
+    }, base_time);
+    std::cout << "auto chose " << (chosen == DijkstraQueue::dial_buckets ? "dial" : chosen == DijkstraQueue::radix_heap ? "radix" : "4-ary heap")
+        << std::endl << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 20;
+    benchmark("grid " + std::to_string(side) + "x" + std::to_string(side), to_csr(grid_graph<double>(side, side, 100, 1)));
+    benchmark("rmat scale " + std::to_string(scale), to_csr(rmat_graph<double>(scale, 8, 100, 2)));
+    for (const int max_weight : {100, 1000000, 10000000}) {
+        benchmark_integral("grid " + std::to_string(side) + "x" + std::to_string(side), to_csr(grid_graph<int>(side, side, max_weight, 1)));
+        benchmark_integral("rmat scale " + std::to_string(scale), to_csr(rmat_graph<int>(scale, 8, max_weight, 2)));
+    }
+    return benchmark_status();
+}
@@ -0,0 +1,79 @@
+// Compares repairing the shortest paths with DynamicShortestPaths after a batch of weight changes with running dijkstra
+// again from scratch, on a road-like grid and on a power-law graph. Every batch makes random edges up to twice as heavy
+// or half as heavy, as travel times do, and the repaired distances are checked against the new search.
+// usage: dynamic_shortest_paths_benchmark [grid side] [rmat scale] [changes per batch]
+// Author: Georgi Kocharyan
+
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "graph_io/edge_list_reader.h"
+#include "shortest_paths/dijkstra.h"
+#include "shortest_paths/dynamic_shortest_paths.h"
+
+using Graph = Digraph<WeightedEdge<double>>;
+
+constexpr unsigned batches = 10;
+
+void benchmark(std::string const & title, EdgeListFile<double> const & file, size_t batch_size)
+{
+    Graph G = to_digraph(file);
+    int source = 0;
+    for (int v = 1; v < G.num_nodes(); v++) {
+        if (G.outdeg(v) > G.outdeg(source)) {
+            source = v;
+        }
+    }
+    std::cout << title << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges, " << batch_size << " changes per batch"
+        << std::endl;
+    // builds the in-edge index as well, which is not part of the repair
+    DynamicShortestPaths paths(G, source);
+
+    std::mt19937_64 rng(4);
+    std::uniform_int_distribution<size_t> pick(0, file.edges.size() - 1);
+    std::uniform_real_distribution<double> factor(0.5, 2);
+    double repair_time = 0;
+    double search_time = 0;
+    size_t recomputed = 0;
+    for (unsigned batch = 0; batch < batches; batch++) {
+        std::vector<WeightChange<double, int>> changes;
+        for (size_t i = 0; i < batch_size; i++) {
+            const auto & edge = file.edges[pick(rng)];
+            double weight = 0;
+            for (const auto & out : G.adjList(edge.from)) {
+                if (out.to == edge.to) {
+                    weight = out.weight;
+                }
+            }
+            changes.push_back({edge.from, edge.to, weight * factor(rng)});
+        }
+        repair_time += best_time(1, [&] { recomputed += paths.update(changes); });
+
+        std::vector<double> min_distances(G.num_nodes(), std::numeric_limits<double>::max());
+        std::vector<int> predecessor(G.num_nodes());
+        search_time += best_time(1, [&] { dijkstra(G, min_distances, source, predecessor); });
+        if (min_distances != paths.distances()) {
+            report_failure() << "the repaired distances differ after batch " << batch << std::endl;
+        }
+    }
+    std::printf("  %-20s %10.4f s per batch\n", "dijkstra", search_time / batches);
+    std::printf("  %-20s %10.4f s per batch %8.1fx, %zu of %zu nodes recomputed per batch\n\n", "repair", repair_time / batches,
+        search_time / repair_time, recomputed / batches, G.num_nodes());
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 20;
+    const size_t batch_size = argc > 3 ? std::stoul(argv[3]) : 2000;
+    benchmark("grid " + std::to_string(side) + "x" + std::to_string(side), grid_graph<double>(side, side, 100, 1), batch_size);
+    benchmark("rmat scale " + std::to_string(scale), rmat_graph<double>(scale, 8, 100, 2), batch_size);
+    return benchmark_status();
+}
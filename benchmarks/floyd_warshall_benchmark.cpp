@@ -0,0 +1,136 @@
+// Compares the blocked Floyd-Warshall of shortest_paths/floyd_warshall.h on one and on all threads, with double, float
+// and 32 bit integer distances, with the former implementation, which kept the matrix as a vector of rows and built
+// every iteration in a second matrix that was then copied back. The results are checked against the former one. Keeping
+// the next hop matrix as well is measured for double and 32 bit integers, and every path read off it is checked.
+// usage: floyd_warshall_benchmark [nodes] [edges per node]
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/timing.h"
+#include "shortest_paths/floyd_warshall.h"
+
+using Graph = CSRDigraph<WeightedEdge<int>>;
+
+// the former floyd_warshall, kept as the baseline
+void copying_floyd_warshall(Graph const & G, std::vector<std::vector<double>> & min_distances)
+{
+    for (int i = 0; i < G.num_nodes(); i++) {
+        min_distances[i][i] = 0;
+    }
+    for (int i = 0; i < G.num_nodes(); i++) {
+        for (const auto & edge : G.adjList(i)) {
+            min_distances[edge.to][edge.from] = edge.weight;
+        }
+    }
+    std::vector<std::vector<double>> temp(G.num_nodes(), std::vector<double>(G.num_nodes()));
+    for (size_t k = 0; k < G.num_nodes(); k++) {
+        for (size_t i = 0; i < G.num_nodes(); i++) {
+            for (size_t j = 0; j < G.num_nodes(); j++) {
+                temp[i][j] = std::min(min_distances[i][j], min_distances[i][k] + min_distances[k][j]);
+            }
+        }
+        for (size_t i = 0; i < G.num_nodes(); i++) {
+            for (size_t j = 0; j < G.num_nodes(); j++) {
+                min_distances[i][j] = temp[i][j];
+            }
+        }
+    }
+}
+
+// the weight of the edge from from to to, which the simple graphs here have at most one of
+int edge_weight(Graph const & G, int from, int to)
+{
+    for (const auto & edge : G.adjList(from)) {
+        if (edge.to == to) {
+            return edge.weight;
+        }
+    }
+    return std::numeric_limits<int>::max();
+}
+
+// with_hops also keeps the next hop matrix, and checks that the paths read off it have the lengths of the distances
+template<typename distance_type>
+void measure(const char * name, Graph const & G, unsigned num_threads, std::vector<std::vector<double>> const & expected, double base_time,
+    bool with_hops = false)
+{
+    DistanceMatrix<distance_type> D;
+    NextHopMatrix next_hop;
+    const double time = best_time(1, [&] { D = with_hops ? floyd_warshall<distance_type>(G, next_hop, num_threads) : floyd_warshall<distance_type>(G, num_threads); });
+    for (size_t i = 0; i < G.num_nodes(); i++) {
+        for (size_t j = 0; j < G.num_nodes(); j++) {
+            const bool reachable = expected[i][j] != std::numeric_limits<double>::max();
+            if (reachable ? D(i, j) != expected[i][j] : D(i, j) != std::numeric_limits<distance_type>::max()) {
+                report_failure() << name << " computes another distance from " << j << " to " << i << std::endl;
+                return;
+            }
+            if (with_hops && reachable) {
+                const std::vector<int32_t> path = next_hop.path(j, i);
+                long long length = 0;
+                for (size_t p = 0; p + 1 < path.size(); p++) {
+                    length += edge_weight(G, path[p], path[p + 1]);
+                }
+                if (path.empty() || path.front() != static_cast<int32_t>(j) || path.back() != static_cast<int32_t>(i) || length != expected[i][j]) {
+                    report_failure() << name << " gives a wrong path from " << j << " to " << i << std::endl;
+                    return;
+                }
+            }
+        }
+    }
+    std::printf("  %-12s %8u %12.3f %9.1fx %12.1f\n", name, num_threads, time, base_time / time,
+        (D.values.size() * sizeof(distance_type) + next_hop.values.size() * sizeof(int32_t)) / 1048576.0);
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t n = argc > 1 ? std::stoul(argv[1]) : 1024;
+    const size_t degree = argc > 2 ? std::stoul(argv[2]) : 4;
+    // random simple graph with conservative weights: integral weights shifted by a potential, so that some are negative
+    // but every cycle has nonnegative weight. The former implementation kept the last of several parallel edges and let
+    // loops overwrite the diagonal, so there are none.
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<int> node(0, n - 1);
+    std::uniform_int_distribution<int> weight(1, 100);
+    std::vector<int> potential(n);
+    for (auto & p : potential) {
+        p = weight(rng) / 2;
+    }
+    std::vector<WeightedEdge<int>> edges;
+    std::set<std::pair<int, int>> joined;
+    while (edges.size() < std::min(n * degree, n * (n - 1))) {
+        const int from = node(rng);
+        const int to = node(rng);
+        if (from != to && joined.insert({from, to}).second) {
+            edges.emplace_back(from, to, weight(rng) + potential[from] - potential[to]);
+        }
+    }
+    const Graph G(n, edges);
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << n << " nodes, " << G.num_edges() << " edges, " << cores << " cores" << std::endl;
+
+    std::vector<std::vector<double>> expected(n, std::vector<double>(n, std::numeric_limits<double>::max()));
+    const double base_time = best_time(1, [&] { copying_floyd_warshall(G, expected); });
+    std::printf("  %-12s %8s %12s %10s %12s\n", "version", "threads", "seconds", "speedup", "matrix MiB");
+    std::printf("  %-12s %8u %12.3f %9.1fx %12.1f\n", "copying", 1, base_time, 1.0, 2.0 * n * n * sizeof(double) / 1048576.0);
+    for (const unsigned threads : {1u, cores}) {
+        measure<double>("double", G, threads, expected, base_time);
+        measure<float>("float", G, threads, expected, base_time);
+        measure<int32_t>("int32", G, threads, expected, base_time);
+        measure<double>("double+hops", G, threads, expected, base_time, true);
+        measure<int32_t>("int32+hops", G, threads, expected, base_time, true);
+        if (cores == 1) {
+            break;
+        }
+    }
+    return benchmark_status();
+}
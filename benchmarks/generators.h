@@ -0,0 +1,99 @@
+// Synthetic graphs for the benchmarks: road-like grids and power-law graphs.
+// Both come with randomly permuted node ids, as real inputs do, so that the ids carry no locality.
+// Author: Georgi Kocharyan
+
+#ifndef BENCHMARKS_GENERATORS_H
+#define BENCHMARKS_GENERATORS_H
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "digraph.h"
+#include "graph_io/edge_list_reader.h"
+
+namespace generators_detail
+{
+    // uniform in [1, max_weight]
+    template<typename weight_type>
+    weight_type random_weight(std::mt19937_64 & rng, weight_type max_weight)
+    {
+        if constexpr (std::is_floating_point_v<weight_type>) {
+            return std::uniform_real_distribution<weight_type>(1, max_weight)(rng);
+        }
+        else {
+            return std::uniform_int_distribution<weight_type>(1, max_weight)(rng);
+        }
+    }
+}
+
+// renames the nodes by a random permutation
+template<typename weight_type, typename node_id_type>
+void shuffle_node_ids(EdgeListFile<weight_type, node_id_type> & file, unsigned seed)
+{
+    std::vector<node_id_type> permutation(file.num_nodes);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), std::mt19937_64(seed));
+    for (auto & edge : file.edges) {
+        edge.from = permutation[edge.from];
+        edge.to = permutation[edge.to];
+    }
+}
+
+// rows x cols grid with an edge in each direction between horizontal and vertical neighbours,
+// a stand-in for road networks: bounded degree, large diameter
+template<typename weight_type = double>
+EdgeListFile<weight_type> grid_graph(size_t rows, size_t cols, weight_type max_weight, unsigned seed)
+{
+    std::mt19937_64 rng(seed);
+    EdgeListFile<weight_type> file;
+    file.num_nodes = rows * cols;
+    file.edges.reserve(4 * rows * cols);
+    auto connect = [&](size_t a, size_t b) {
+        file.edges.emplace_back(a, b, generators_detail::random_weight(rng, max_weight));
+        file.edges.emplace_back(b, a, generators_detail::random_weight(rng, max_weight));
+    };
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            if (c + 1 < cols) {
+                connect(r * cols + c, r * cols + c + 1);
+            }
+            if (r + 1 < rows) {
+                connect(r * cols + c, (r + 1) * cols + c);
+            }
+        }
+    }
+    shuffle_node_ids(file, seed + 1);
+    return file;
+}
+
+// R-MAT graph (Chakrabarti et al.) with 2^scale nodes and edge_factor edges per node on average, a stand-in for
+// web and social graphs: skewed degrees, small diameter. Every edge picks one quadrant of the adjacency matrix per bit.
+template<typename weight_type = double>
+EdgeListFile<weight_type> rmat_graph(unsigned scale, size_t edge_factor, weight_type max_weight, unsigned seed)
+{
+    constexpr double a = 0.57;
+    constexpr double b = 0.19;
+    constexpr double c = 0.19;
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> coin(0, 1);
+    EdgeListFile<weight_type> file;
+    file.num_nodes = size_t(1) << scale;
+    file.edges.reserve(edge_factor * file.num_nodes);
+    for (size_t e = 0; e < edge_factor * file.num_nodes; e++) {
+        size_t from = 0;
+        size_t to = 0;
+        for (unsigned bit = 0; bit < scale; bit++) {
+            const double p = coin(rng);
+            from = 2 * from + (p >= a + b);
+            to = 2 * to + ((p >= a && p < a + b) || p >= a + b + c);
+        }
+        file.edges.emplace_back(from, to, generators_detail::random_weight(rng, max_weight));
+    }
+    shuffle_node_ids(file, seed + 1);
+    return file;
+}
+
+#endif //BENCHMARKS_GENERATORS_H
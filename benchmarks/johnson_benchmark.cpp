@@ -0,0 +1,81 @@
+// Compares Johnson's algorithm with the blocked Floyd-Warshall on a sparse road-like grid whose weights are shifted by
+// random potentials, so that many of them are negative but no cycle is. Johnson's rows are passed to a callback, which
+// checks them against Floyd-Warshall, and are also written to a file.
+// usage: johnson_benchmark [grid side] [threads]
+// Author: Georgi Kocharyan
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "shortest_paths/floyd_warshall.h"
+#include "shortest_paths/johnson.h"
+
+using Graph = CSRDigraph<WeightedEdge<double>>;
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 64;
+    const unsigned threads = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    EdgeListFile<double> file = grid_graph<double>(side, side, 100, 1);
+    std::mt19937_64 rng(2);
+    std::uniform_real_distribution<double> shift(0, 100);
+    std::vector<double> potential(file.num_nodes);
+    for (auto & p : potential) {
+        p = shift(rng);
+    }
+    size_t negative = 0;
+    for (auto & edge : file.edges) {
+        edge.weight += potential[edge.from] - potential[edge.to];
+        negative += edge.weight < 0;
+    }
+    const Graph G = to_csr(file);
+    std::cout << "grid " << side << "x" << side << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges, " << negative
+        << " negative, " << threads << " threads" << std::endl;
+
+    DistanceMatrix<double> expected;
+    const double floyd_time = best_time(1, [&] { expected = floyd_warshall<double>(G, threads); });
+    std::printf("  %-24s %10.3f s %10.1f MiB\n", "floyd_warshall", floyd_time, expected.values.size() * sizeof(double) / 1048576.0);
+
+    size_t wrong = 0;
+    const double johnson_time = best_time(1, [&] {
+        johnson(G, [&](int source, std::vector<double> const & distances) {
+            for (int v = 0; v < G.num_nodes(); v++) {
+                const double e = expected(v, source);
+                const bool reachable = e != std::numeric_limits<double>::max();
+                if (reachable != (distances[v] != std::numeric_limits<double>::max()) || (reachable && std::abs(distances[v] - e) > 1e-9 * (1 + std::abs(e)))) {
+                    wrong++;
+                }
+            }
+        }, threads);
+    });
+    if (wrong > 0) {
+        report_failure() << "johnson computes " << wrong << " other distances" << std::endl;
+    }
+    std::printf("  %-24s %10.3f s %9.1fx\n", "johnson, callback", johnson_time, floyd_time / johnson_time);
+
+    const std::string path = "johnson_benchmark.distances";
+    const double file_time = best_time(1, [&] { write_all_pairs_distances(G, path, threads); });
+    std::printf("  %-24s %10.3f s %9.1fx\n", "johnson, to file", file_time, floyd_time / file_time);
+    std::mt19937_64 pick(3);
+    for (int check = 0; check < 10; check++) {
+        const int source = std::uniform_int_distribution<int>(0, G.num_nodes() - 1)(pick);
+        const std::vector<double> row = read_distance_row(path, source);
+        for (int v = 0; v < G.num_nodes(); v++) {
+            if (std::abs(row[v] - expected(v, source)) > 1e-9 * (1 + std::abs(expected(v, source)))) {
+                report_failure() << "the file holds another distance from " << source << " to " << v << std::endl;
+                break;
+            }
+        }
+    }
+    std::remove(path.c_str());
+    return benchmark_status();
+}
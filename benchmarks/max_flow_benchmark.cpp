@@ -0,0 +1,147 @@
+// Compares push_relabel with the Edmonds-Karp algorithm of max_flows/edmonds_karp.cpp, on a road-like grid between two
+// random nodes and on a power-law graph between the nodes of largest out- and in-degree. The capacities are integral, so
+// that both values are exact, and the flows on the edges are checked for capacities and conservation.
+// usage: max_flow_benchmark [grid side] [rmat scale]
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "graph_io/edge_list_reader.h"
+#include "max_flows/flow_check.h"
+#include "max_flows/push_relabel.h"
+
+using Network = Digraph<NetworkEdge<double>>;
+using Edge_n = NetworkEdge<double>;
+
+// the Edmonds-Karp algorithm of max_flows/edmonds_karp.cpp, kept as the baseline
+void bfs(Network & G, const int & source, const int & sink, std::vector<Edge_n*> & predecessors, bool & found)
+{
+    std::queue<Edge_n*> q;
+    Edge_n start(-1,source,1,0);
+    q.push(&start);
+    std::vector<bool> vis(G.num_nodes(), false);
+    while (!q.empty()) {
+        Edge_n* edge = q.front();
+        q.pop();
+        if (vis[edge->to] || found) {
+            continue;
+        }
+        vis[edge->to] = true;
+        predecessors[edge->to] = edge;
+        for (auto & neighbour: G.adjList_ref(edge->to)) {
+            if (neighbour.rest_capacity() == 0) {
+                continue;
+            }
+            if (neighbour.to != sink) {
+                q.push(&neighbour);
+            }
+            else {
+                predecessors[sink] = &neighbour;
+                found = true;
+                predecessors[source] = nullptr;
+                return;
+            }
+        }
+    }
+}
+
+double edmonds_karp(Network & G, int source, int sink)
+{
+    double max_flow = 0;
+    for (int node_id = 0; node_id < G.num_nodes(); ++node_id) {
+        for (auto & edge: G.adjList_ref(node_id)) {
+            if (!edge.reversed) {
+                Edge_n edge_reversed(edge.to,edge.from,edge.capacity,0);
+                edge_reversed.reversed = true;
+                edge_reversed.partner = &edge;
+                G.add_edge(edge_reversed);
+                edge.partner = &G.adjList_ref(edge.to).back();
+            }
+        }
+    }
+    bool found_path = true;
+    while (found_path) {
+        std::vector<Edge_n*> predecessors(G.num_nodes(), nullptr);
+        found_path = false;
+        bfs(G, source,sink, predecessors, found_path);
+        if (found_path) {
+            double augment = std::numeric_limits<double>::max();
+            int node_id = sink;
+            std::list<Edge_n*> path;
+            while (node_id != source) {
+                path.push_back(predecessors[node_id]);
+                augment = std::min(augment, predecessors[node_id]->rest_capacity());
+                node_id = predecessors[node_id]->from;
+            }
+            for (auto & edge: path) {
+                if (!edge->reversed) {
+                    edge->pump(augment);
+                    edge->partner->pump(augment);
+                }
+                else {
+                    edge->pump(-augment);
+                    edge->partner->pump(-augment);
+                }
+            }
+            max_flow += augment;
+        }
+    }
+    return max_flow;
+}
+
+void benchmark(std::string const & title, EdgeListFile<double> file, int source, int sink)
+{
+    for (auto & edge : file.edges) {
+        edge.weight = std::round(edge.weight);
+    }
+    std::cout << title << ": " << file.num_nodes << " nodes, " << file.edges.size() << " edges, from " << source << " to " << sink
+        << std::endl;
+    double baseline_value = 0;
+    double value = 0;
+    Network baseline_G = to_network(file);
+    Network G = to_network(file);
+    const double baseline_time = best_time(1, [&] { baseline_value = edmonds_karp(baseline_G, source, sink); });
+    const double time = best_time(1, [&] { value = push_relabel(G, source, sink); });
+    if (value != baseline_value) {
+        report_failure() << "the maximum flows differ: " << value << " and " << baseline_value << std::endl;
+    }
+    if (!is_flow(G, source, sink, value, true, 1e-6)) {
+        report_failure() << "push_relabel did not return a valid flow" << std::endl;
+    }
+    std::printf("  %-14s %10.4f s, maximum flow %g\n", "edmonds-karp", baseline_time, baseline_value);
+    std::printf("  %-14s %10.4f s %8.1fx\n\n", "push-relabel", time, baseline_time / time);
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 300;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 12;
+
+    EdgeListFile<double> grid = grid_graph<double>(side, side, 100, 1);
+    // the node ids are shuffled, so these are two random nodes
+    benchmark("grid " + std::to_string(side) + "x" + std::to_string(side), grid, 0, static_cast<int>(grid.num_nodes - 1));
+
+    EdgeListFile<double> rmat = rmat_graph<double>(scale, 8, 100, 2);
+    std::vector<size_t> outdeg(rmat.num_nodes);
+    std::vector<size_t> indeg(rmat.num_nodes);
+    for (auto const & edge : rmat.edges) {
+        outdeg[edge.from]++;
+        indeg[edge.to]++;
+    }
+    const int source = std::max_element(outdeg.begin(), outdeg.end()) - outdeg.begin();
+    indeg[source] = 0;
+    const int sink = std::max_element(indeg.begin(), indeg.end()) - indeg.begin();
+    benchmark("rmat scale " + std::to_string(scale), rmat, source, sink);
+    return benchmark_status();
+}
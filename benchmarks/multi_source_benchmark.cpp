@@ -0,0 +1,110 @@
+// Computes distances from batches of 8 to 64 random sources, once with one run of dijkstra or breadth first search per
+// source and once with the batched multi-source searches, on a road-like grid and on a power-law graph. The batched
+// distances are checked against the single-source ones.
+// usage: multi_source_benchmark [grid side] [rmat scale]
+// Author: Georgi Kocharyan
+
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "graph_io/edge_list_reader.h"
+#include "shortest_paths/dijkstra.h"
+#include "shortest_paths/multi_source.h"
+
+using Graph = CSRDigraph<WeightedEdge<double>>;
+using UnweightedGraph = CSRDigraph<Edge>;
+
+// number of edges on a shortest path from source to every node, the maximum of int if there is none
+std::vector<int> bfs(UnweightedGraph const & G, int source)
+{
+    std::vector<int> distances(G.num_nodes(), std::numeric_limits<int>::max());
+    std::queue<int> queue;
+    distances[source] = 0;
+    queue.push(source);
+    while (!queue.empty()) {
+        const int node = queue.front();
+        queue.pop();
+        for (const auto & edge : G.adjList(node)) {
+            if (distances[edge.to] == std::numeric_limits<int>::max()) {
+                distances[edge.to] = distances[node] + 1;
+                queue.push(edge.to);
+            }
+        }
+    }
+    return distances;
+}
+
+void benchmark(std::string const & title, Graph const & G)
+{
+    std::vector<Edge> edges;
+    edges.reserve(G.num_edges());
+    for (int node = 0; node < G.num_nodes(); node++) {
+        for (const auto & edge : G.adjList(node)) {
+            edges.emplace_back(edge.from, edge.to);
+        }
+    }
+    const UnweightedGraph U(G.num_nodes(), edges);
+    std::cout << title << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges" << std::endl;
+    std::printf("  %8s %14s %14s %9s %14s %14s %9s\n", "sources", "dijkstra ms", "batched ms", "speedup", "bfs ms", "bit bfs ms", "speedup");
+
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<int> node(0, G.num_nodes() - 1);
+    for (const size_t k : {8, 16, 32, 64}) {
+        std::vector<int> sources(k);
+        for (auto & source : sources) {
+            source = node(rng);
+        }
+
+        std::vector<std::vector<double>> expected(k);
+        const double dijkstra_time = best_time(1, [&] {
+            std::vector<int> predecessor;
+            for (size_t i = 0; i < k; i++) {
+                expected[i].assign(G.num_nodes(), std::numeric_limits<double>::max());
+                predecessor.assign(G.num_nodes(), sources[i]);
+                dijkstra(G, expected[i], sources[i], predecessor);
+            }
+        });
+        DistanceMatrix<double> batched;
+        const double batched_time = best_time(1, [&] { batched = multi_source_shortest_paths(G, std::span<const int>(sources)); });
+
+        std::vector<std::vector<int>> expected_hops(k);
+        const double bfs_time = best_time(1, [&] {
+            for (size_t i = 0; i < k; i++) {
+                expected_hops[i] = bfs(U, sources[i]);
+            }
+        });
+        DistanceMatrix<int> hops;
+        const double bit_bfs_time = best_time(1, [&] { hops = multi_source_bfs(U, std::span<const int>(sources)); });
+
+        for (size_t i = 0; i < k; i++) {
+            for (int v = 0; v < G.num_nodes(); v++) {
+                if (batched(v, i) != expected[i][v]) {
+                    report_failure() << "batched search computes another distance from source " << i << " to " << v << std::endl;
+                }
+                if (hops(v, i) != expected_hops[i][v]) {
+                    report_failure() << "bit-parallel bfs computes another distance from source " << i << " to " << v << std::endl;
+                }
+            }
+        }
+        std::printf("  %8zu %14.2f %14.2f %8.2fx %14.2f %14.2f %8.2fx\n", k, 1e3 * dijkstra_time, 1e3 * batched_time,
+            dijkstra_time / batched_time, 1e3 * bfs_time, 1e3 * bit_bfs_time, bfs_time / bit_bfs_time);
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 300;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 17;
+    benchmark("grid " + std::to_string(side) + "x" + std::to_string(side), to_csr(grid_graph<double>(side, side, 100, 1)));
+    benchmark("rmat scale " + std::to_string(scale), to_csr(rmat_graph<double>(scale, 8, 100, 2)));
+    return benchmark_status();
+}
@@ -0,0 +1,89 @@
+// Compares parallel_moore_bellman_ford on one and on all threads with the sequential moore_bellman_ford and with spfa,
+// on a road-like grid and on a power-law graph whose weights are shifted by random potentials, so that many are
+// negative but no cycle is. The distances are checked against moore_bellman_ford, and the predecessors of the parallel
+// runs against each other.
+// usage: parallel_bellman_ford_benchmark [grid side] [rmat scale] [threads]
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "graph_io/edge_list_reader.h"
+#include "shortest_paths/moore_bellman_ford.h"
+#include "shortest_paths/parallel_bellman_ford.h"
+
+using Graph = CSRDigraph<WeightedEdge<double>>;
+
+void benchmark(std::string const & title, EdgeListFile<double> file, unsigned threads)
+{
+    std::mt19937_64 rng(2);
+    std::uniform_real_distribution<double> shift(0, 100);
+    std::vector<double> potential(file.num_nodes);
+    for (auto & p : potential) {
+        p = shift(rng);
+    }
+    for (auto & edge : file.edges) {
+        edge.weight += potential[edge.from] - potential[edge.to];
+    }
+    const Graph G = to_csr(file);
+    // the source is the node with the most out-edges, so that it reaches much of the graph
+    int source = 0;
+    for (int v = 0; v < G.num_nodes(); v++) {
+        if (G.outdeg(v) > G.outdeg(source)) {
+            source = v;
+        }
+    }
+    std::cout << title << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges" << std::endl;
+    std::printf("  %-24s %12s %10s\n", "search", "seconds", "speedup");
+
+    std::vector<double> expected(G.num_nodes(), std::numeric_limits<double>::max());
+    bool negative_cycle = false;
+    const double sequential_time = best_time(1, [&] { moore_bellman_ford(G, expected, source, negative_cycle); });
+    std::printf("  %-24s %12.3f %9.1fx\n", "moore_bellman_ford", sequential_time, 1.0);
+
+    std::vector<int> first_predecessor;
+    for (const unsigned t : {1u, threads}) {
+        std::vector<double> min_distances(G.num_nodes(), std::numeric_limits<double>::max());
+        std::vector<int> predecessor(G.num_nodes(), -1);
+        bool parallel_cycle = false;
+        const double time = best_time(1, [&] { parallel_moore_bellman_ford(G, min_distances, source, predecessor, parallel_cycle, t); });
+        if (parallel_cycle != negative_cycle || min_distances != expected) {
+            report_failure() << "parallel_moore_bellman_ford computes other distances on " << t << " threads" << std::endl;
+        }
+        if (first_predecessor.empty()) {
+            first_predecessor = predecessor;
+        }
+        else if (predecessor != first_predecessor) {
+            report_failure() << "the predecessors depend on the number of threads" << std::endl;
+        }
+        const std::string name = "parallel, " + std::to_string(t) + " threads";
+        std::printf("  %-24s %12.3f %9.1fx\n", name.c_str(), time, sequential_time / time);
+    }
+
+    std::vector<double> queued(G.num_nodes(), std::numeric_limits<double>::max());
+    std::vector<int> predecessor(G.num_nodes());
+    const double spfa_time = best_time(1, [&] { spfa(G, queued, source, predecessor); });
+    if (queued != expected) {
+        report_failure() << "spfa computes other distances" << std::endl;
+    }
+    std::printf("  %-24s %12.3f %9.1fx\n\n", "spfa", spfa_time, sequential_time / spfa_time);
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 300;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 17;
+    const unsigned threads = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+    benchmark("grid " + std::to_string(side) + "x" + std::to_string(side), grid_graph<double>(side, side, 100, 1), threads);
+    benchmark("rmat scale " + std::to_string(scale), rmat_graph<double>(scale, 8, 100, 2), threads);
+    return benchmark_status();
+}
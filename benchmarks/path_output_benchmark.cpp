@@ -0,0 +1,83 @@
+// Compares writing all shortest paths of a dijkstra search with write_shortest_paths, which reads them off a
+// ShortestPathTree into one buffer, with the former output of shortest_paths/dijkstra.cpp, which walked the
+// predecessors and flushed every line with std::endl, on a road-like grid. Both write to a file, which is then removed.
+// usage: path_output_benchmark [grid side]
+// Author: Georgi Kocharyan
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "graph_io/edge_list_reader.h"
+#include "shortest_paths/dijkstra.h"
+#include "shortest_paths/shortest_path_tree.h"
+
+using Graph = CSRDigraph<WeightedEdge<double>>;
+
+// the former output of dijkstra.cpp, kept as the baseline
+void print_shortest_paths(std::ostream & out, Graph const & G, std::vector<double> const & min_distances, int measuring_from,
+    std::vector<int> const & predecessor)
+{
+    out << measuring_from << " is the root node." << std::endl;
+    for (int i = 0; i < G.num_nodes(); ++i) {
+        if (i == measuring_from) {
+            continue;
+        }
+        out << i;
+        if (min_distances[i] == std::numeric_limits<double>::max()) {
+            out << " is inaccessible from " << measuring_from << "." << std::endl;
+        }
+        else {
+            int pred = predecessor[i];
+            while (pred != measuring_from) {
+                out << " - " << pred;
+                pred = predecessor[pred];
+            }
+            out << " - " << measuring_from << " is the shortest path with total weight " << min_distances[i] << "." << std::endl;
+        }
+    }
+}
+
+// the whole content of a file
+std::string contents(std::string const & path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 200;
+    const Graph G = to_csr(grid_graph<double>(side, side, 100, 1));
+    const int source = 0;
+    std::vector<double> min_distances(G.num_nodes(), std::numeric_limits<double>::max());
+    std::vector<int> predecessor(G.num_nodes(), source);
+    dijkstra(G, min_distances, source, predecessor);
+    std::cout << "grid " << side << "x" << side << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges" << std::endl;
+
+    const std::string former_path = "path_output_benchmark.former";
+    const std::string path = "path_output_benchmark.paths";
+    const double former_time = best_time(1, [&] {
+        std::ofstream out(former_path);
+        print_shortest_paths(out, G, min_distances, source, predecessor);
+    });
+    const double tree_time = best_time(1, [&] {
+        std::ofstream out(path);
+        write_shortest_paths(out, ShortestPathTree(source, predecessor, min_distances), min_distances);
+    });
+    const std::string text = contents(path);
+    if (text != contents(former_path)) {
+        report_failure() << "write_shortest_paths writes something else" << std::endl;
+    }
+    std::printf("  %-24s %10.3f s\n", "predecessors, std::endl", former_time);
+    std::printf("  %-24s %10.3f s %9.1fx, %.1f MiB\n", "tree, one buffer", tree_time, former_time / tree_time, text.size() / 1048576.0);
+    std::remove(former_path.c_str());
+    std::remove(path.c_str());
+    return benchmark_status();
+}
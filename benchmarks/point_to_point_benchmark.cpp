@@ -0,0 +1,109 @@
+// Answers random source-target queries with point-to-point searches and compares the nodes they settle and their time
+// with a full run of dijkstra, on a road-like grid and on a power-law graph. The distances are checked against dijkstra.
+// The preprocessing of ALT is timed as well, together with storing and loading its tables.
+// usage: point_to_point_benchmark [grid side] [rmat scale] [queries] [landmarks]
+// Author: Georgi Kocharyan
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "shortest_paths/alt.h"
+#include "shortest_paths/bidirectional_dijkstra.h"
+#include "shortest_paths/dijkstra.h"
+
+using Graph = CSRDigraph<WeightedEdge<double>>;
+
+void report(const char * name, double time, double settled, size_t queries, double base_time, double base_settled)
+{
+    std::printf("  %-16s %14.0f %9.1fx %12.3f %9.1fx\n", name, settled / queries, base_settled / settled, 1e3 * time / queries,
+        base_time / time);
+}
+
+template<typename search_type>
+void measure(const char * name, search_type & search, std::vector<std::pair<int, int>> const & pairs, std::vector<double> const & expected,
+    double base_time, double base_settled)
+{
+    // the first query builds the in-edge index, if the search uses one
+    search.query(0, 0);
+    double settled = 0;
+    const double time = best_time(1, [&] {
+        settled = 0;
+        for (size_t q = 0; q < pairs.size(); q++) {
+            const ShortestPath<int> result = search.query(pairs[q].first, pairs[q].second);
+            settled += result.settled;
+            if (std::abs(result.distance - expected[q]) > 1e-9 * std::abs(expected[q])) {
+                report_failure() << name << " computes another distance for query " << q << std::endl;
+            }
+        }
+    });
+    report(name, time, settled, pairs.size(), base_time, base_settled);
+}
+
+void benchmark(std::string const & title, Graph const & G, size_t queries, size_t num_landmarks)
+{
+    std::cout << title << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges, " << queries << " queries" << std::endl;
+    std::printf("  %-16s %14s %10s %12s %10s\n", "search", "settled/query", "fewer", "ms/query", "speedup");
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<int> node(0, G.num_nodes() - 1);
+    std::vector<std::pair<int, int>> pairs(queries);
+    for (auto & pair : pairs) {
+        pair = {node(rng), node(rng)};
+    }
+
+    // a full dijkstra settles every node reachable from the source
+    std::vector<double> expected(queries);
+    double dijkstra_settled = 0;
+    const double dijkstra_time = best_time(1, [&] {
+        std::vector<double> min_distances;
+        std::vector<int> predecessor;
+        dijkstra_settled = 0;
+        for (size_t q = 0; q < queries; q++) {
+            min_distances.assign(G.num_nodes(), std::numeric_limits<double>::max());
+            predecessor.assign(G.num_nodes(), pairs[q].first);
+            dijkstra(G, min_distances, pairs[q].first, predecessor);
+            expected[q] = min_distances[pairs[q].second];
+            for (const double distance : min_distances) {
+                dijkstra_settled += distance != std::numeric_limits<double>::max();
+            }
+        }
+    });
+    report("dijkstra", dijkstra_time, dijkstra_settled, queries, dijkstra_time, dijkstra_settled);
+
+    BidirectionalDijkstra<Graph> bidirectional(G);
+    measure("bidirectional", bidirectional, pairs, expected, dijkstra_time, dijkstra_settled);
+
+    const std::string path = "point_to_point_benchmark.landmarks";
+    for (const auto selection : {LandmarkSelection::farthest, LandmarkSelection::avoid}) {
+        const char * name = selection == LandmarkSelection::farthest ? "alt farthest" : "alt avoid";
+        LandmarkTables<int> tables;
+        const double preprocessing = best_time(1, [&] { tables = compute_landmarks(G, num_landmarks, selection); });
+        const double store = best_time(1, [&] { write_landmarks(tables, path); });
+        const double load = best_time(1, [&] { tables = read_landmarks<int>(path); });
+        const size_t loaded = tables.size();
+        ALT<Graph> alt(G, std::move(tables));
+        measure(name, alt, pairs, expected, dijkstra_time, dijkstra_settled);
+        std::printf("    %zu landmarks: preprocessing %.3f s, store %.3f s, load %.3f s\n", loaded, preprocessing, store, load);
+    }
+    std::remove(path.c_str());
+    std::cout << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 20;
+    const size_t queries = argc > 3 ? std::stoul(argv[3]) : 20;
+    const size_t num_landmarks = argc > 4 ? std::stoul(argv[4]) : 16;
+    benchmark("grid " + std::to_string(side) + "x" + std::to_string(side), to_csr(grid_graph<double>(side, side, 100, 1)), queries, num_landmarks);
+    benchmark("rmat scale " + std::to_string(scale), to_csr(rmat_graph<double>(scale, 8, 100, 2)), queries, num_landmarks);
+    return benchmark_status();
+}
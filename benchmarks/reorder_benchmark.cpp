@@ -0,0 +1,88 @@
+// Measures how much the node orders of reordering/node_order.h speed up dijkstra and the edge sweeps of
+// moore_bellman_ford, on a road-like grid and on a power-law graph whose node ids are randomly permuted.
+// usage: reorder_benchmark [grid side] [rmat scale]
+// Author: Georgi Kocharyan
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "reordering/node_order.h"
+#include "shortest_paths/dijkstra.h"
+#include "shortest_paths/edge_arrays.h"
+
+using Graph = CSRDigraph<WeightedEdge<double>>;
+
+constexpr unsigned repetitions = 3;
+constexpr int sweeps = 10;
+
+std::vector<double> run_dijkstra(Graph const & G, int measuring_from)
+{
+    std::vector<double> min_distances(G.num_nodes(), std::numeric_limits<double>::max());
+    std::vector<int> predecessor(G.num_nodes(), measuring_from);
+    dijkstra(G, min_distances, measuring_from, predecessor);
+    return min_distances;
+}
+
+void benchmark(std::string const & title, Graph const & G)
+{
+    std::cout << title << ": " << G.num_nodes() << " nodes, " << G.num_edges() << " edges" << std::endl;
+    std::printf("%-10s %10s %12s %8s %12s %8s\n", "order", "order [s]", "dijkstra [s]", "speedup", "sweeps [s]", "speedup");
+    // the searches start in the node of largest outdegree, which reaches most of the graph also in the power-law case
+    int source = 0;
+    for (int i = 1; i < G.num_nodes(); i++) {
+        if (G.outdeg(i) > G.outdeg(source)) {
+            source = i;
+        }
+    }
+    const std::vector<double> expected = run_dijkstra(G, source);
+    double dijkstra_base = 0;
+    double sweep_base = 0;
+    for (const char * name : {"original", "degree", "bfs", "dfs", "rcm", "gorder"}) {
+        std::vector<int> order;
+        const double order_time = best_time(1, [&] { order = compute_node_order(G, parse_node_order(name)); });
+        const Graph H = relabel(G, order);
+        const int measuring_from = inverse_order(order)[source];
+
+        std::vector<double> min_distances;
+        const double dijkstra_time = best_time(repetitions, [&] { min_distances = run_dijkstra(H, measuring_from); });
+        const std::vector<double> restored = to_original_order(H, min_distances);
+        for (size_t i = 0; i < restored.size(); i++) {
+            if (std::abs(restored[i] - expected[i]) > 1e-9 * std::abs(expected[i])) {
+                report_failure() << name << " order changes the distance of node " << i << std::endl;
+                break;
+            }
+        }
+
+        // at the fixed point no entry changes, so every order does the same work
+        const EdgeArrays<double> edges(H);
+        const double sweep_time = best_time(repetitions, [&] {
+            for (int i = 0; i < sweeps; i++) {
+                relax_all_edges(edges, min_distances.data(), min_distances.data());
+            }
+        });
+
+        if (dijkstra_base == 0) {
+            dijkstra_base = dijkstra_time;
+            sweep_base = sweep_time;
+        }
+        std::printf("%-10s %10.3f %12.3f %7.2fx %12.3f %7.2fx\n", name, order_time, dijkstra_time, dijkstra_base / dijkstra_time,
+            sweep_time, sweep_base / sweep_time);
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 18;
+    benchmark("grid " + std::to_string(side) + "x" + std::to_string(side), to_csr(grid_graph<double>(side, side, 100, 1)));
+    benchmark("rmat scale " + std::to_string(scale), to_csr(rmat_graph<double>(scale, 8, 100, 2)));
+    return benchmark_status();
+}
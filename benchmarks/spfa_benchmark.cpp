@@ -0,0 +1,96 @@
+// Compares spfa with moore_bellman_ford, which sweeps over all edges until a round changes nothing, and with the former
+// moore_bellman_ford, which always ran n - 1 sweeps, on a road-like grid and on a power-law graph whose weights are
+// shifted by random potentials, so that many are negative but no cycle is. Then one edge is made negative enough to
+// close a negative cycle, which is reachable from the source on these graphs, and the time until it is detected is compared. The distances are checked against each other.
+// usage: spfa_benchmark [grid side] [rmat scale]
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "benchmarks/generators.h"
+#include "benchmarks/timing.h"
+#include "graph_io/edge_list_reader.h"
+#include "shortest_paths/edge_arrays.h"
+#include "shortest_paths/moore_bellman_ford.h"
+
+using Graph = CSRDigraph<WeightedEdge<double>>;
+
+// the former moore_bellman_ford, kept as the baseline
+void fixed_rounds_bellman_ford(Graph const & G, std::vector<double> & min_distances, int measuring_from, bool & negative_cycle)
+{
+    const EdgeArrays<double> edges(G);
+    min_distances[measuring_from] = 0;
+    for (size_t i = 1; i < G.num_nodes(); i++) {
+        relax_all_edges(edges, min_distances.data(), min_distances.data());
+    }
+    if (relax_all_edges(edges, min_distances.data(), min_distances.data())) {
+        negative_cycle = true;
+    }
+}
+
+void benchmark(std::string const & title, EdgeListFile<double> file)
+{
+    std::mt19937_64 rng(2);
+    std::uniform_real_distribution<double> shift(0, 100);
+    std::vector<double> potential(file.num_nodes);
+    for (auto & p : potential) {
+        p = shift(rng);
+    }
+    for (auto & edge : file.edges) {
+        edge.weight += potential[edge.from] - potential[edge.to];
+    }
+    // the source is the node with the most out-edges, so that it reaches much of the graph
+    std::vector<size_t> outdeg(file.num_nodes);
+    for (auto const & edge : file.edges) {
+        outdeg[edge.from]++;
+    }
+    const int source = std::max_element(outdeg.begin(), outdeg.end()) - outdeg.begin();
+
+    std::cout << title << ": " << file.num_nodes << " nodes, " << file.edges.size() << " edges" << std::endl;
+    std::printf("  %-10s %16s %16s %16s\n", "", "n - 1 rounds", "early exit", "spfa");
+    for (const bool with_cycle : {false, true}) {
+        if (with_cycle) {
+            // a random edge closes a negative cycle with any path back to its tail
+            file.edges[std::uniform_int_distribution<size_t>(0, file.edges.size() - 1)(rng)].weight = -1e6;
+        }
+        const Graph G = to_csr(file);
+        std::vector<double> fixed(G.num_nodes(), std::numeric_limits<double>::max());
+        std::vector<double> early = fixed;
+        std::vector<double> queued = fixed;
+        std::vector<int> predecessor(G.num_nodes(), source);
+        bool fixed_cycle = false;
+        bool early_cycle = false;
+        std::vector<int> cycle;
+        const double fixed_time = best_time(1, [&] { fixed_rounds_bellman_ford(G, fixed, source, fixed_cycle); });
+        const double early_time = best_time(1, [&] { moore_bellman_ford(G, early, source, early_cycle); });
+        const double spfa_time = best_time(1, [&] { cycle = spfa(G, queued, source, predecessor); });
+        if (fixed_cycle != early_cycle || early_cycle != !cycle.empty() || (!cycle.empty()) != with_cycle) {
+            report_failure() << "the searches disagree on the negative cycle" << std::endl;
+        }
+        else if (!with_cycle && (fixed != early || early != queued)) {
+            report_failure() << "the searches compute other distances" << std::endl;
+        }
+        std::printf("  %-10s %14.3f s %14.3f s %14.3f s", with_cycle ? "cycle" : "no cycle", fixed_time, early_time, spfa_time);
+        if (with_cycle) {
+            std::printf("   cycle of %zu nodes", cycle.size());
+        }
+        std::printf("\n");
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    const size_t side = argc > 1 ? std::stoul(argv[1]) : 100;
+    const unsigned scale = argc > 2 ? std::stoul(argv[2]) : 14;
+    benchmark("grid " + std::to_string(side) + "x" + std::to_string(side), grid_graph<double>(side, side, 100, 1));
+    benchmark("rmat scale " + std::to_string(scale), rmat_graph<double>(scale, 8, 100, 2));
+    return benchmark_status();
+}
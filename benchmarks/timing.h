@@ -0,0 +1,45 @@
+// Wall clock timing for the benchmarks, and the count of wrong results they found, which makes the run fail.
+// Author: Georgi Kocharyan
+
+#ifndef BENCHMARKS_TIMING_H
+#define BENCHMARKS_TIMING_H
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+// runs f repetitions times and returns the fastest run in seconds, which is the least disturbed by other processes
+template<typename function_type>
+double best_time(unsigned repetitions, function_type && f)
+{
+    double best = std::numeric_limits<double>::max();
+    for (unsigned r = 0; r < repetitions; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+inline int & benchmark_failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+// counts a wrong result and returns the stream to describe it on
+inline std::ostream & report_failure()
+{
+    benchmark_failures()++;
+    return std::cerr;
+}
+
+// the exit status of a benchmark, nonzero if any result was wrong
+inline int benchmark_status()
+{
+    return benchmark_failures() > 0 ? 1 : 0;
+}
+
+#endif //BENCHMARKS_TIMING_H
@@ -8,7 +8,9 @@
 
 using UndirectedGraph = Digraph<Edge>;
 
-void dfs(UndirectedGraph const & G, const Edge edge, std::vector<bool> & vis, std::vector<int> & node_order, std::vector<int> & lowpoint, int & time, std::vector<Edge> & bridges) {
+template<IsDigraph graph_type>
+void dfs(graph_type const & G, const BasicEdge<typename graph_type::node_id_type> edge, std::vector<bool> & vis, std::vector<size_t> & node_order, std::vector<size_t> & lowpoint,
+    size_t & time, std::vector<BasicEdge<typename graph_type::node_id_type>> & bridges) {
 
     vis[edge.to] = true;
     node_order[edge.to] = time;
@@ -17,7 +19,7 @@ void dfs(UndirectedGraph const & G, const Edge edge, std::vector<bool> & vis, st
     // go through the DFS and compute lowpoint along the way
     // lowpoint(v) is the earliest time reached in the DFS among all neighbours of descendants of v
     // it turns out that if (v,w) is in the DFS, then it is a bridge iff lowpoint(w) > time(v).
-    for(const auto i: G.adjList(edge.to))
+    for(const auto & i: G.adjList(edge.to))
     {
         if (vis[i.to])
         {
@@ -34,15 +36,18 @@ void dfs(UndirectedGraph const & G, const Edge edge, std::vector<bool> & vis, st
     }
 
 }
-std::vector<Edge> tarjan(const UndirectedGraph & G)
+template<IsDigraph graph_type>
+std::vector<BasicEdge<typename graph_type::node_id_type>> tarjan(const graph_type & G)
 {
-    int time = 0;
-    std::vector<Edge> bridges;
+    using node_id_type = typename graph_type::node_id_type;
+    size_t time = 0;
+    std::vector<BasicEdge<node_id_type>> bridges;
     bridges.reserve(G.num_edges());
     std::vector<bool> vis(G.num_nodes(), false);
-    std::vector<int> node_order(G.num_nodes());
-    std::vector<int> lowpoint(G.num_nodes());
-    const Edge fake_edge(-1,0);
+    std::vector<size_t> node_order(G.num_nodes());
+    std::vector<size_t> lowpoint(G.num_nodes());
+    // the root has no parent, -1 is never the id of a node (also not when wrapped around in an unsigned type)
+    const BasicEdge<node_id_type> fake_edge(static_cast<node_id_type>(-1), 0);
     dfs(G,fake_edge,vis,node_order,lowpoint,time,bridges);
     return bridges;
 }
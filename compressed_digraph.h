@@ -0,0 +1,437 @@
+// Read-only unweighted digraph with compressed neighbour lists, for graphs that do not fit into memory as Digraph or CSRDigraph.
+// Every neighbour list is sorted and stored as gaps: the first target relative to the node itself, zigzag encoded as it
+// may be smaller, every further target relative to the one before. With a node order that keeps neighbours close together
+// (see reordering/node_order.h) most gaps fit into one byte.
+// The gaps are written either as varints, 7 bits per byte with the top bit marking that more bytes follow, or as group
+// varints, where one tag byte holds the lengths of the next four values so that they are decoded without a branch per byte.
+// adjList decodes on the fly and yields BasicEdge objects, so the algorithms written for Digraph run on it unchanged.
+// Author: Georgi Kocharyan
+
+#ifndef COMPRESSED_DIGRAPH_H
+#define COMPRESSED_DIGRAPH_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "digraph.h"
+
+enum class GapEncoding
+{
+    varint,
+    group_varint
+};
+
+namespace compressed_detail
+{
+    inline void put_varint(std::vector<uint8_t> & out, uint64_t value)
+    {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    inline uint64_t get_varint(const uint8_t * & pos)
+    {
+        uint64_t value = *pos++;
+        // most gaps are small, so check for the single byte case first
+        if (value < 0x80) {
+            return value;
+        }
+        value &= 0x7f;
+        for (unsigned shift = 7; ; shift += 7) {
+            const uint64_t byte = *pos++;
+            value |= (byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+    }
+
+    inline uint64_t zigzag(int64_t value)
+    {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    inline int64_t unzigzag(uint64_t value)
+    {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    // writes the values in groups of four: a tag byte with the length of each value minus one in two bits,
+    // then the values in little endian order. The tag of an incomplete last group marks its missing values as one byte long.
+    inline void put_group_varint(std::vector<uint8_t> & out, std::vector<uint32_t> const & values)
+    {
+        for (size_t i = 0; i < values.size(); i += 4) {
+            const size_t tag_pos = out.size();
+            out.push_back(0);
+            uint8_t tag = 0;
+            for (size_t j = 0; j < 4 && i + j < values.size(); j++) {
+                const uint32_t value = values[i + j];
+                const unsigned length = value < (1u << 8) ? 1 : value < (1u << 16) ? 2 : value < (1u << 24) ? 3 : 4;
+                tag |= (length - 1) << (2 * j);
+                for (unsigned b = 0; b < length; b++) {
+                    out.push_back(static_cast<uint8_t>(value >> (8 * b)));
+                }
+            }
+            out[tag_pos] = tag;
+        }
+    }
+
+    // decodes a group of four values. Every value is read as a full 4 byte word and masked, so this reads up to
+    // 3 + 4 bytes past the end of the last group, which the padding at the end of the byte array allows for.
+    inline const uint8_t * get_group_varint(const uint8_t * pos, uint32_t * values)
+    {
+        const unsigned tag = *pos++;
+        for (unsigned j = 0; j < 4; j++) {
+            const unsigned length = ((tag >> (2 * j)) & 3) + 1;
+            if constexpr (std::endian::native == std::endian::little) {
+                uint32_t word;
+                std::memcpy(&word, pos, sizeof(word));
+                values[j] = word & (0xffffffffu >> (32 - 8 * length));
+            }
+            else {
+                values[j] = 0;
+                for (unsigned b = 0; b < length; b++) {
+                    values[j] |= static_cast<uint32_t>(pos[b]) << (8 * b);
+                }
+            }
+            pos += length;
+        }
+        return pos;
+    }
+
+    constexpr size_t padding = 8;
+}
+
+// offset_t is the type of the byte offsets of the neighbour lists, 32 bits suffice as long as the encoded graph stays below 4 GiB
+template<typename node_id_t = int, typename offset_t = uint64_t>
+class CompressedDigraph
+{
+public:
+    using edge_type = BasicEdge<node_id_t>;
+    using weight_type = typename edge_type::weight_type;
+    using node_id_type = node_id_t;
+    using edge_count_type = offset_t;
+
+    class EdgeIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = edge_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = edge_type;
+
+        EdgeIterator() = default;
+
+        // reversed iterators belong to the reverse index and yield the edges with from and to swapped back
+        EdgeIterator(CompressedDigraph const * graph, node_id_type node_id, bool reversed) : node_id(node_id), reversed(reversed)
+        {
+            encoding = graph->gap_encoding;
+            pos = graph->bytes.data() + graph->offsets[node_id];
+            remaining = compressed_detail::get_varint(pos);
+            if (remaining > 0) {
+                current = static_cast<node_id_type>(static_cast<int64_t>(node_id) + compressed_detail::unzigzag(compressed_detail::get_varint(pos)));
+            }
+        }
+
+        edge_type operator*() const
+        {
+            return reversed ? edge_type(current, node_id) : edge_type(node_id, current);
+        }
+
+        EdgeIterator & operator++()
+        {
+            if (--remaining > 0) {
+                current += next_gap();
+            }
+            return *this;
+        }
+
+        EdgeIterator operator++(int)
+        {
+            EdgeIterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        // only iterators over the same list are compared, the end iterator has nothing left
+        bool operator==(EdgeIterator const & other) const
+        {
+            return remaining == other.remaining;
+        }
+
+    private:
+        const uint8_t * pos = nullptr;
+        uint64_t remaining = 0;
+        node_id_type node_id = 0;
+        node_id_type current = 0;
+        bool reversed = false;
+        GapEncoding encoding = GapEncoding::varint;
+        uint32_t group[4] = {};
+        unsigned in_group = 4;
+
+        node_id_type next_gap()
+        {
+            if (encoding == GapEncoding::varint) {
+                return static_cast<node_id_type>(compressed_detail::get_varint(pos));
+            }
+            if (in_group == 4) {
+                pos = compressed_detail::get_group_varint(pos, group);
+                in_group = 0;
+            }
+            return static_cast<node_id_type>(group[in_group++]);
+        }
+    };
+
+    class EdgeRange
+    {
+    public:
+        EdgeRange(CompressedDigraph const * graph, node_id_type node_id, bool reversed) : graph(graph), node_id(node_id), reversed(reversed) {}
+        EdgeIterator begin() const { return EdgeIterator(graph, node_id, reversed); }
+        EdgeIterator end() const { return EdgeIterator(); }
+        edge_count_type size() const { return graph->outdeg(node_id); }
+        bool empty() const { return size() == 0; }
+
+    private:
+        CompressedDigraph const * graph;
+        node_id_type node_id;
+        bool reversed;
+    };
+
+    template<IsDigraph graph_type>
+    explicit CompressedDigraph(graph_type const & G, GapEncoding encoding = GapEncoding::varint);
+
+    // the edges may be given in any order
+    template<typename any_edge_type>
+    CompressedDigraph(size_t num_nodes, std::vector<any_edge_type> const & edge_list, GapEncoding encoding = GapEncoding::varint);
+
+    size_t num_nodes() const;
+
+    edge_count_type num_edges() const;
+
+    edge_count_type outdeg(node_id_type node_id) const;
+
+    EdgeRange adjList(node_id_type node_id) const;
+
+    // the edges into node_id. They come from a compressed copy of the transposed graph, built on the first call.
+    // Building it is not thread-safe: call index_in_edges() before sharing the graph between threads.
+    EdgeRange inAdjList(node_id_type node_id) const;
+
+    void index_in_edges() const;
+
+    std::vector<edge_count_type> indegrees() const;
+
+    GapEncoding encoding() const;
+
+    // bytes taken by the encoded lists and their offsets, not counting the reverse index
+    size_t memory_bytes() const;
+
+private:
+    GapEncoding gap_encoding;
+    std::vector<offset_t> offsets;
+    std::vector<uint8_t> bytes;
+    edge_count_type edges = 0;
+    mutable std::shared_ptr<const CompressedDigraph> reverse;
+
+    explicit CompressedDigraph(GapEncoding encoding) : gap_encoding(encoding) {}
+
+    // builds the graph from neighbour lists given as offsets into one array of targets
+    template<typename index_type>
+    void encode_all(size_t num_nodes, std::vector<index_type> const & target_offsets, std::vector<node_id_type> & targets);
+
+    void append_list(node_id_type node_id, node_id_type * first, node_id_type * last);
+
+    // the offset of the next list, or after the last list the end of the encoded bytes
+    void append_offset();
+};
+
+template<typename node_id_t, typename offset_t>
+template<IsDigraph graph_type>
+CompressedDigraph<node_id_t, offset_t>::CompressedDigraph(graph_type const & G, GapEncoding encoding) : gap_encoding(encoding)
+{
+    check_node_count<node_id_type>(G.num_nodes());
+    offsets.reserve(G.num_nodes() + 1);
+    std::vector<node_id_type> targets;
+    for (node_id_type v = 0; v < G.num_nodes(); v++) {
+        targets.clear();
+        for (auto const & edge : G.adjList(v)) {
+            targets.push_back(edge.to);
+        }
+        append_list(v, targets.data(), targets.data() + targets.size());
+    }
+    append_offset();
+    bytes.resize(bytes.size() + compressed_detail::padding, 0);
+}
+
+template<typename node_id_t, typename offset_t>
+template<typename any_edge_type>
+CompressedDigraph<node_id_t, offset_t>::CompressedDigraph(size_t num_nodes, std::vector<any_edge_type> const & edge_list, GapEncoding encoding)
+    : gap_encoding(encoding)
+{
+    check_node_count<node_id_type>(num_nodes);
+    // counting sort by from node
+    std::vector<size_t> target_offsets(num_nodes + 1, 0);
+    for (auto const & edge : edge_list) {
+        ++target_offsets[edge.from + 1];
+    }
+    for (size_t i = 0; i < num_nodes; i++) {
+        target_offsets[i + 1] += target_offsets[i];
+    }
+    std::vector<node_id_type> targets(edge_list.size());
+    std::vector<size_t> next(target_offsets.begin(), target_offsets.end() - 1);
+    for (auto const & edge : edge_list) {
+        targets[next[edge.from]++] = edge.to;
+    }
+    encode_all(num_nodes, target_offsets, targets);
+}
+
+template<typename node_id_t, typename offset_t>
+template<typename index_type>
+void CompressedDigraph<node_id_t, offset_t>::encode_all(size_t num_nodes, std::vector<index_type> const & target_offsets,
+    std::vector<node_id_type> & targets)
+{
+    offsets.reserve(num_nodes + 1);
+    for (node_id_type v = 0; v < num_nodes; v++) {
+        append_list(v, targets.data() + target_offsets[v], targets.data() + target_offsets[v + 1]);
+    }
+    append_offset();
+    bytes.resize(bytes.size() + compressed_detail::padding, 0);
+}
+
+template<typename node_id_t, typename offset_t>
+void CompressedDigraph<node_id_t, offset_t>::append_list(node_id_type node_id, node_id_type * first, node_id_type * last)
+{
+    using namespace compressed_detail;
+    append_offset();
+    std::sort(first, last);
+    const size_t degree = last - first;
+    edges += degree;
+    put_varint(bytes, degree);
+    if (degree == 0) {
+        return;
+    }
+    put_varint(bytes, zigzag(static_cast<int64_t>(*first) - static_cast<int64_t>(node_id)));
+    if (gap_encoding == GapEncoding::varint) {
+        for (node_id_type * target = first + 1; target < last; target++) {
+            put_varint(bytes, static_cast<uint64_t>(*target - *(target - 1)));
+        }
+        return;
+    }
+    std::vector<uint32_t> gaps;
+    gaps.reserve(degree - 1);
+    for (node_id_type * target = first + 1; target < last; target++) {
+        const uint64_t gap = static_cast<uint64_t>(*target - *(target - 1));
+        if (gap > std::numeric_limits<uint32_t>::max()) {
+            throw std::invalid_argument("group varints hold gaps of at most 32 bits");
+        }
+        gaps.push_back(static_cast<uint32_t>(gap));
+    }
+    put_group_varint(bytes, gaps);
+}
+
+template<typename node_id_t, typename offset_t>
+void CompressedDigraph<node_id_t, offset_t>::append_offset()
+{
+    if (bytes.size() > std::numeric_limits<offset_t>::max()) {
+        throw std::length_error("compressed graph does not fit offsets of the chosen type");
+    }
+    offsets.push_back(bytes.size());
+}
+
+template<typename node_id_t, typename offset_t>
+size_t CompressedDigraph<node_id_t, offset_t>::num_nodes() const
+{
+    return offsets.size() - 1;
+}
+
+template<typename node_id_t, typename offset_t>
+typename CompressedDigraph<node_id_t, offset_t>::edge_count_type CompressedDigraph<node_id_t, offset_t>::num_edges() const
+{
+    return edges;
+}
+
+template<typename node_id_t, typename offset_t>
+typename CompressedDigraph<node_id_t, offset_t>::edge_count_type CompressedDigraph<node_id_t, offset_t>::outdeg(node_id_type node_id) const
+{
+    const uint8_t * pos = bytes.data() + offsets[node_id];
+    return compressed_detail::get_varint(pos);
+}
+
+template<typename node_id_t, typename offset_t>
+typename CompressedDigraph<node_id_t, offset_t>::EdgeRange CompressedDigraph<node_id_t, offset_t>::adjList(node_id_type node_id) const
+{
+    return EdgeRange(this, node_id, false);
+}
+
+template<typename node_id_t, typename offset_t>
+typename CompressedDigraph<node_id_t, offset_t>::EdgeRange CompressedDigraph<node_id_t, offset_t>::inAdjList(node_id_type node_id) const
+{
+    index_in_edges();
+    return EdgeRange(reverse.get(), node_id, true);
+}
+
+template<typename node_id_t, typename offset_t>
+void CompressedDigraph<node_id_t, offset_t>::index_in_edges() const
+{
+    if (reverse) {
+        return;
+    }
+    // counting sort of the edges by target, decoding the graph twice instead of holding a list of all edges
+    const std::vector<edge_count_type> indegs = indegrees();
+    std::vector<size_t> source_offsets(num_nodes() + 1, 0);
+    for (size_t i = 0; i < num_nodes(); i++) {
+        source_offsets[i + 1] = source_offsets[i] + indegs[i];
+    }
+    std::vector<node_id_type> sources(num_edges());
+    std::vector<size_t> next(source_offsets.begin(), source_offsets.end() - 1);
+    for (node_id_type v = 0; v < num_nodes(); v++) {
+        for (auto const & edge : adjList(v)) {
+            sources[next[edge.to]++] = v;
+        }
+    }
+    std::shared_ptr<CompressedDigraph> transposed(new CompressedDigraph(gap_encoding));
+    transposed->encode_all(num_nodes(), source_offsets, sources);
+    reverse = std::move(transposed);
+}
+
+template<typename node_id_t, typename offset_t>
+std::vector<typename CompressedDigraph<node_id_t, offset_t>::edge_count_type> CompressedDigraph<node_id_t, offset_t>::indegrees() const
+{
+    std::vector<edge_count_type> indegs(num_nodes(), 0);
+    if (reverse) {
+        for (node_id_type v = 0; v < num_nodes(); v++) {
+            indegs[v] = reverse->outdeg(v);
+        }
+        return indegs;
+    }
+    for (node_id_type v = 0; v < num_nodes(); v++) {
+        for (auto const & edge : adjList(v)) {
+            ++indegs[edge.to];
+        }
+    }
+    return indegs;
+}
+
+template<typename node_id_t, typename offset_t>
+GapEncoding CompressedDigraph<node_id_t, offset_t>::encoding() const
+{
+    return gap_encoding;
+}
+
+template<typename node_id_t, typename offset_t>
+size_t CompressedDigraph<node_id_t, offset_t>::memory_bytes() const
+{
+    return offsets.size() * sizeof(offset_t) + bytes.size();
+}
+
+#endif //COMPRESSED_DIGRAPH_H
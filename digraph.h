@@ -5,31 +5,45 @@
 #define C___DIGRAPH_H
 
 #include <list>
+#include <memory>
+#include <memory_resource>
+#include <span>
 #include <vector>
 #include <concepts>
 #include <algorithm>
 #include <limits>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 
 
-struct Edge
+// node ids are of type node_id_t, which has to be able to hold the number of nodes of the graph, see check_node_count.
+// int is the default; 16 bit ids save memory traffic on small graphs, 64 bit ids allow huge ones.
+template<typename node_id_t = int>
+struct BasicEdge
 {
     using weight_type = bool;
-    int from;
-    int to;
-    Edge(int from_id, int to_id) : from(from_id), to(to_id)
+    using node_id_type = node_id_t;
+    node_id_type from;
+    node_id_type to;
+    BasicEdge(node_id_type from_id, node_id_type to_id) : from(from_id), to(to_id)
     {
     }
 };
 
-template<typename weight_t>
-struct WeightedEdge : public Edge
+using Edge = BasicEdge<>;
+
+template<typename weight_t, typename node_id_t = int>
+struct WeightedEdge : public BasicEdge<node_id_t>
 {
     using weight_type = weight_t;
+    using node_id_type = node_id_t;
     weight_type weight;
-    WeightedEdge(int from_id, int to_id) : Edge(from_id, to_id), weight(0)
+    WeightedEdge(node_id_type from_id, node_id_type to_id) : BasicEdge<node_id_t>(from_id, to_id), weight(0)
     {
     }
-    WeightedEdge(int from_id, int to_id, weight_type wgt) : Edge(from_id,to_id), weight(wgt)
+    WeightedEdge(node_id_type from_id, node_id_type to_id, weight_type wgt) : BasicEdge<node_id_t>(from_id,to_id), weight(wgt)
     {
     }
 
@@ -39,10 +53,11 @@ struct WeightedEdge : public Edge
     }
 };
 
-template<typename weight_t>
-struct NetworkEdge : Edge
+template<typename weight_t, typename node_id_t = int>
+struct NetworkEdge : BasicEdge<node_id_t>
 {
     using weight_type = weight_t;
+    using node_id_type = node_id_t;
     weight_t capacity;
     weight_t flow;
     bool marking;
@@ -50,7 +65,7 @@ struct NetworkEdge : Edge
     NetworkEdge* partner; // in residual graphs the reverse edge representing reducing flow
     // NetworkEdge(Edge edge); // flow always initialised to zero
     // NetworkEdge(Edge edge, NetworkEdge* represents);
-    NetworkEdge(int from, int to, double capacity, double flow) : Edge(from,to), capacity(capacity), marking(false), reversed(false), flow(flow) {};
+    NetworkEdge(node_id_type from, node_id_type to, double capacity, double flow) : BasicEdge<node_id_t>(from,to), capacity(capacity), marking(false), reversed(false), flow(flow) {};
     void pump(double additional_flow);
     double rest_capacity() const; // determines how much can still be pumped through
     void mark();
@@ -76,77 +91,207 @@ concept HasFlow = requires (E e)
     {e.capacity};
 };
 
+// the common interface of Digraph and CSRDigraph that the read-only algorithms rely on
+template<typename G>
+concept IsDigraph = requires (G const g, typename G::node_id_type node_id)
+{
+    {g.num_nodes()};
+    {g.num_edges()};
+    {g.outdeg(node_id)};
+    {g.adjList(node_id).begin()};
+    {g.adjList(node_id).end()};
+};
+
+// graphs that can also be traversed backwards, along the edges into a node
+template<typename G>
+concept HasInEdges = IsDigraph<G> && requires (G const g, typename G::node_id_type node_id)
+{
+    {g.inAdjList(node_id).begin()};
+    {g.inAdjList(node_id).end()};
+};
+
+// throws unless node_id_type can hold num_nodes. The count itself has to fit, not just the largest id, so that loops
+// over the nodes can run on node_id_type and its maximum stays free as a marker for no node.
+template<typename node_id_type>
+void check_node_count(size_t num_nodes)
+{
+    if (num_nodes > static_cast<size_t>(std::numeric_limits<node_id_type>::max())) {
+        throw std::length_error("the number of nodes does not fit the node id type");
+    }
+}
+
+// throws unless edge_index_t can hold num_edges, which is the offset after the last adjacency list
+template<typename edge_index_t>
+void check_edge_count(size_t num_edges)
+{
+    if (num_edges > static_cast<size_t>(std::numeric_limits<edge_index_t>::max())) {
+        throw std::length_error("the number of edges does not fit the edge index type");
+    }
+}
+
 template<typename edge_type>
 struct Node
 {
     using weight_type = typename edge_type::weight_type;
+    using node_id_type = typename edge_type::node_id_type;
 
-    std::list<edge_type> neighbours;
+    std::pmr::list<edge_type> neighbours;
 
-    int name;
+    node_id_type name;
 
     Node() = default;
 
+    explicit Node(std::pmr::memory_resource * resource) : neighbours(resource), name(0) {}
+
     explicit Node(std::list<int> neighbours_) : neighbours(std::move(neighbours_)), name(0) {}
 
     Node(std::list<Edge> neighbours_, int name_) : neighbours(std::move(neighbours_)), name(name_) {}
 
-    void add_edge(int from, int to, weight_type weight) requires IsWeighted<edge_type>;
+    void add_edge(node_id_type from, node_id_type to, weight_type weight) requires IsWeighted<edge_type>;
 
-    void add_edge(int from, int to);
+    void add_edge(node_id_type from, node_id_type to);
 
     void add_edge(edge_type edge);
 
-    int outdeg() const;
+    size_t outdeg() const;
 
-    void give_name(int new_name);
+    void give_name(node_id_type new_name);
 };
 
-template<typename edge_type>
+// edge_count_t counts edges, and is therefore also the type of degrees. Graphs with more than 2^31 edges need
+// a 64 bit type here, see Digraph64.
+template<typename edge_type, typename edge_count_t = int>
 class Digraph
 {
+public:
     using weight_type = typename edge_type::weight_type;
+    using node_id_type = typename edge_type::node_id_type;
+    using edge_count_type = edge_count_t;
 
-public:
+    class InEdgeIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = edge_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = edge_type const *;
+        using reference = edge_type const &;
+
+        InEdgeIterator() = default;
+        explicit InEdgeIterator(typename std::vector<edge_type const *>::const_iterator pos) : pos(pos) {}
+
+        edge_type const & operator*() const
+        {
+            return **pos;
+        }
+
+        edge_type const * operator->() const
+        {
+            return *pos;
+        }
+
+        InEdgeIterator & operator++()
+        {
+            ++pos;
+            return *this;
+        }
+
+        InEdgeIterator operator++(int)
+        {
+            InEdgeIterator old = *this;
+            ++pos;
+            return old;
+        }
+
+        bool operator==(InEdgeIterator const & other) const
+        {
+            return pos == other.pos;
+        }
+
+    private:
+        typename std::vector<edge_type const *>::const_iterator pos;
+    };
+
+    class InEdgeRange
+    {
+    public:
+        explicit InEdgeRange(std::vector<edge_type const *> const & edges) : edges(&edges) {}
+        InEdgeIterator begin() const { return InEdgeIterator(edges->begin()); }
+        InEdgeIterator end() const { return InEdgeIterator(edges->end()); }
+        size_t size() const { return edges->size(); }
+        bool empty() const { return edges->empty(); }
+
+    private:
+        std::vector<edge_type const *> const * edges;
+    };
+
+    // the edge lists are allocated from resource if one is given, otherwise from a pool arena owned by the graph, so that
+    // building and destroying a graph does not go through the general purpose allocator once per edge. The pool reuses
+    // the memory of removed edges, a monotonic resource given here never does.
     template<typename U = edge_type>
-    explicit Digraph(std::enable_if_t<IsWeighted<U>, size_t> num_nodes) : nodes(num_nodes)
+    explicit Digraph(std::enable_if_t<IsWeighted<U>, size_t> num_nodes, std::pmr::memory_resource * resource = nullptr)
     {
+        allocate_nodes(num_nodes, resource);
         edges = 0;
         std::vector<edge_type> v;
         v.reserve(num_nodes);
-        for (int i = 0; i < num_nodes; i++) {
+        for (node_id_type i = 0; i < num_nodes; i++) {
             v.emplace_back(0, i, std::numeric_limits<weight_type>::max());
         }
         mins = v;
-        max = std::numeric_limits<weight_type>::min();
+        max = std::numeric_limits<weight_type>::lowest();
     }
 
     template<typename U = edge_type>
-    explicit Digraph(std::enable_if_t<(!IsWeighted<U>), size_t> num_nodes) : nodes(num_nodes)
+    explicit Digraph(std::enable_if_t<(!IsWeighted<U>), size_t> num_nodes, std::pmr::memory_resource * resource = nullptr)
     {
+        allocate_nodes(num_nodes, resource);
         edges = 0;
         max = 0;
     }
 
-    void add_edge(int from, int to, weight_type weight) requires IsWeighted<edge_type>;
+    // the copy gets an arena of its own, unless the original uses an external resource, which is then shared
+    Digraph(Digraph const & other);
 
-    void add_edge(int from, int to) requires (!IsWeighted<edge_type>);
+    Digraph(Digraph && other) noexcept = default;
 
-    void add_edge(int from, int to, weight_type capacity, weight_type flow) requires (HasFlow<edge_type> && !IsWeighted<edge_type>);
+    Digraph & operator=(Digraph other) noexcept;
+
+    void add_edge(node_id_type from, node_id_type to, weight_type weight) requires IsWeighted<edge_type>;
+
+    void add_edge(node_id_type from, node_id_type to) requires (!IsWeighted<edge_type>);
+
+    void add_edge(node_id_type from, node_id_type to, weight_type capacity, weight_type flow) requires (HasFlow<edge_type> && !IsWeighted<edge_type>);
 
     void add_edge(edge_type edge);
 
-    int node_name(int node_id) const;
+    // gives every edge from from to to the new weight and returns the smallest weight they had before, or the maximum of
+    // weight_type if there is no such edge. min_ingoing_edge stays exact, while get_max() is only ever raised, so after
+    // lowering the largest weight it remains an upper bound on the weights. Keeping min_ingoing_edge exact needs the
+    // in-edges of to, so the in-edge index, O(n + m) time and memory, has to be built by index_in_edges() beforehand;
+    // without it set_weight throws std::logic_error instead of building it on the quiet.
+    weight_type set_weight(node_id_type from, node_id_type to, weight_type weight) requires IsWeighted<edge_type>;
+
+    node_id_type node_name(node_id_type node_id) const;
+
+    // read-only view of the out-edges of node_id, valid until the graph is modified or destroyed
+    std::pmr::list<edge_type> const & adjList(node_id_type node_id) const;
 
-    std::list<edge_type> adjList(int node_id) const;
+    // mutable access to the out-edges of node_id. Edges may be removed through it, so it drops the in-edge index.
+    std::pmr::list<edge_type> &adjList_ref(node_id_type node_id);
 
-    std::list<edge_type> &adjList_ref(int node_id);
+    // the edges into node_id, as references to the edges in the lists of their from nodes. The index behind this is built
+    // on the first call and then kept up to date by add_edge and pop_edge, so that reverse traversals need no transposed
+    // copy of the graph. Building it is not thread-safe: call index_in_edges() before sharing the graph between threads.
+    InEdgeRange inAdjList(node_id_type node_id) const;
 
-    int num_edges() const;
+    void index_in_edges() const;
 
-    edge_type min_ingoing_edge(int node_id) const requires IsWeighted<edge_type>;
+    edge_count_type num_edges() const;
 
-    Digraph contract_set(std::vector<int> const & v, std::vector<edge_type> & min_edges_in, std::vector<edge_type> & min_edges_out) const;
+    edge_type min_ingoing_edge(node_id_type node_id) const requires IsWeighted<edge_type>;
+
+    Digraph contract_set(std::vector<node_id_type> const & v, std::vector<edge_type> & min_edges_in, std::vector<edge_type> & min_edges_out) const;
 
     size_t num_nodes() const;
 
@@ -156,48 +301,59 @@ public:
 
     Digraph modified_weights() const requires IsWeighted<edge_type>;
 
-    void name_node(int node_id, int new_name);
+    void name_node(node_id_type node_id, node_id_type new_name);
 
-    int node_name(int node_id);
+    node_id_type node_name(node_id_type node_id);
 
-    Digraph<Edge> lose_weight() const requires IsWeighted<edge_type>;
+    Digraph<BasicEdge<node_id_type>, edge_count_t> lose_weight() const requires IsWeighted<edge_type>;
 
     Digraph remove_parallel_min() const requires IsWeighted<edge_type>;
 
-    Digraph<edge_type> remove_parallel() const;
+    Digraph remove_parallel() const;
 
     void double_edges();
 
-    bool isEdge(int from, int to) const;
+    bool isEdge(node_id_type from, node_id_type to) const;
 
-    int outdeg(int node_id) const;
+    edge_count_type outdeg(node_id_type node_id) const;
 
     weight_type get_max() const;
 
-    std::vector<int> indegrees() const;
+    std::vector<edge_count_type> indegrees() const;
 
-    edge_type pop_edge(int node_id);
+    edge_type pop_edge(node_id_type node_id);
 
     void mark() requires HasMarking<edge_type>;
 
     void unmark() requires HasMarking<edge_type>;
 
+    // the memory resource given on construction, or nullptr if the graph allocates from its own arena.
+    // graphs derived from this one are built with it, so they share an external resource or get their own arena.
+    std::pmr::memory_resource * external_resource() const;
+
 private:
+    // declared before nodes so that it is destroyed after all edge lists have released their memory into it
+    std::unique_ptr<std::pmr::unsynchronized_pool_resource> arena;
+    std::pmr::memory_resource * resource;
     std::vector<Node<edge_type>> nodes;
-    int edges;
-    int max;
+    edge_count_type edges;
+    weight_type max;
     std::vector<edge_type> mins;
-    bool dfs(int v, std::vector<bool> & visited, std::vector<bool> & possible, std::vector<edge_type> & cycle) const;
+    // in_edges[v] points to every edge into v, list elements never move, so the pointers stay valid while edges are added
+    mutable std::unique_ptr<std::vector<std::vector<edge_type const *>>> in_edges;
+    void index_last_edge(node_id_type from);
+    bool dfs(node_id_type v, std::vector<bool> & visited, std::vector<bool> & possible, std::vector<edge_type> & cycle) const;
+    void allocate_nodes(size_t num_nodes, std::pmr::memory_resource * external);
 };
 
-template<typename weight_t>
-void NetworkEdge<weight_t>::pump(double additional_flow)
+template<typename weight_t, typename node_id_t>
+void NetworkEdge<weight_t, node_id_t>::pump(double additional_flow)
 {
     flow += additional_flow;
 }
 
-template<typename weight_t>
-double NetworkEdge<weight_t>::rest_capacity() const
+template<typename weight_t, typename node_id_t>
+double NetworkEdge<weight_t, node_id_t>::rest_capacity() const
 {
     if (reversed) {
         return flow;
@@ -205,26 +361,26 @@ double NetworkEdge<weight_t>::rest_capacity() const
     return capacity - flow;
 }
 
-template<typename weight_t>
-void NetworkEdge<weight_t>::mark()
+template<typename weight_t, typename node_id_t>
+void NetworkEdge<weight_t, node_id_t>::mark()
 {
     marking = true;
 }
 
-template<typename weight_t>
-void NetworkEdge<weight_t>::unmark()
+template<typename weight_t, typename node_id_t>
+void NetworkEdge<weight_t, node_id_t>::unmark()
 {
     marking = false;
 }
 
 template<typename edge_type>
-void Node<edge_type>::add_edge(int from, int to, weight_type weight) requires IsWeighted<edge_type>
+void Node<edge_type>::add_edge(node_id_type from, node_id_type to, weight_type weight) requires IsWeighted<edge_type>
 {
     neighbours.emplace_back(from, to, weight);
 }
 
 template<typename edge_type>
-void Node<edge_type>::add_edge(int from, int to)
+void Node<edge_type>::add_edge(node_id_type from, node_id_type to)
 {
     neighbours.emplace_back(from, to);
 }
@@ -236,21 +392,70 @@ void Node<edge_type>::add_edge(edge_type edge)
 }
 
 template<typename edge_type>
-int Node<edge_type>::outdeg() const
+size_t Node<edge_type>::outdeg() const
 {
     return neighbours.size();
 }
 
 template<typename edge_type>
-void Node<edge_type>::give_name(const int new_name)
+void Node<edge_type>::give_name(const node_id_type new_name)
 {
     name = new_name;
 }
 
-template<typename edge_type>
-void Digraph<edge_type>::add_edge(int from, int to, weight_type weight) requires IsWeighted<edge_type>
+template<typename edge_type, typename edge_count_t>
+Digraph<edge_type, edge_count_t>::Digraph(Digraph const & other) : edges(other.edges), max(other.max), mins(other.mins)
+{
+    allocate_nodes(other.num_nodes(), other.external_resource());
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        // assign keeps the allocator of the target list, a copy constructor would fall back to the default resource
+        nodes[i].neighbours.assign(other.nodes[i].neighbours.begin(), other.nodes[i].neighbours.end());
+        nodes[i].name = other.nodes[i].name;
+    }
+}
+
+template<typename edge_type, typename edge_count_t>
+Digraph<edge_type, edge_count_t> & Digraph<edge_type, edge_count_t>::operator=(Digraph other) noexcept
+{
+    // swapping the node vectors only exchanges buffers, every edge list stays with the arena it was allocated from
+    std::swap(arena, other.arena);
+    std::swap(resource, other.resource);
+    std::swap(nodes, other.nodes);
+    std::swap(edges, other.edges);
+    std::swap(max, other.max);
+    std::swap(mins, other.mins);
+    std::swap(in_edges, other.in_edges);
+    return *this;
+}
+
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::allocate_nodes(size_t num_nodes, std::pmr::memory_resource * external)
+{
+    check_node_count<node_id_type>(num_nodes);
+    if (external == nullptr) {
+        arena = std::make_unique<std::pmr::unsynchronized_pool_resource>();
+        resource = arena.get();
+    }
+    else {
+        resource = external;
+    }
+    nodes.reserve(num_nodes);
+    for (node_id_type i = 0; i < num_nodes; i++) {
+        nodes.emplace_back(resource);
+    }
+}
+
+template<typename edge_type, typename edge_count_t>
+std::pmr::memory_resource * Digraph<edge_type, edge_count_t>::external_resource() const
+{
+    return arena ? nullptr : resource;
+}
+
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::add_edge(node_id_type from, node_id_type to, weight_type weight) requires IsWeighted<edge_type>
 {
     nodes[from].add_edge(from, to, weight);
+    index_last_edge(from);
     edges++;
     // check if weight of newly added edge is smaller than the min, and update accordingly
     // the entries of min should not be interpreted as Edges
@@ -263,72 +468,148 @@ void Digraph<edge_type>::add_edge(int from, int to, weight_type weight) requires
     }
 }
 
-template<typename edge_type>
-void Digraph<edge_type>::add_edge(int from, int to) requires (!IsWeighted<edge_type>)
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::add_edge(node_id_type from, node_id_type to) requires (!IsWeighted<edge_type>)
 {
     nodes[from].add_edge(from, to);
+    index_last_edge(from);
     edges++;
 }
 
-template<typename edge_type>
-void Digraph<edge_type>::add_edge(int from, int to, weight_type capacity, weight_type flow) requires (HasFlow<edge_type> && !IsWeighted<edge_type>)
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::add_edge(node_id_type from, node_id_type to, weight_type capacity, weight_type flow) requires (HasFlow<edge_type> && !IsWeighted<edge_type>)
 {
     nodes[from].neighbours.emplace_back(from, to, capacity, flow);
+    index_last_edge(from);
     edges++;
 }
 
-template<typename edge_type>
-void Digraph<edge_type>::add_edge(edge_type edge)
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::add_edge(edge_type edge)
 {
     nodes[edge.from].add_edge(edge);
+    index_last_edge(edge.from);
     edges++;
 }
 
-template<typename edge_type>
-int Digraph<edge_type>::node_name(int node_id) const
+template<typename edge_type, typename edge_count_t>
+typename Digraph<edge_type, edge_count_t>::weight_type Digraph<edge_type, edge_count_t>::set_weight(node_id_type from, node_id_type to,
+    weight_type weight) requires IsWeighted<edge_type>
+{
+    if (!in_edges) {
+        throw std::logic_error("set_weight needs the in-edge index, call index_in_edges() first");
+    }
+    constexpr weight_type absent = std::numeric_limits<weight_type>::max();
+    weight_type previous = absent;
+    // the list elements are changed in place, so the in-edge index stays valid
+    for (auto & edge : nodes[from].neighbours) {
+        if (edge.to == to) {
+            previous = std::min(previous, edge.weight);
+            edge.weight = weight;
+        }
+    }
+    if (previous == absent) {
+        return previous;
+    }
+    if (weight > max) {
+        max = weight;
+    }
+    if (weight < mins[to].weight) {
+        mins[to] = edge_type(from, to, weight);
+    }
+    else if (mins[to].from == from && weight > mins[to].weight) {
+        // the lightest edge into to became heavier, another one may be the lightest now
+        mins[to] = edge_type(0, to, std::numeric_limits<weight_type>::max());
+        for (auto const & edge : inAdjList(to)) {
+            if (edge.weight < mins[to].weight) {
+                mins[to] = edge_type(edge.from, to, edge.weight);
+            }
+        }
+    }
+    return previous;
+}
+
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::index_last_edge(node_id_type from)
+{
+    if (in_edges) {
+        edge_type const & edge = nodes[from].neighbours.back();
+        (*in_edges)[edge.to].push_back(&edge);
+    }
+}
+
+template<typename edge_type, typename edge_count_t>
+typename Digraph<edge_type, edge_count_t>::node_id_type Digraph<edge_type, edge_count_t>::node_name(node_id_type node_id) const
 {
     return nodes[node_id].name;
 }
 
-template<typename edge_type>
-std::list<edge_type> Digraph<edge_type>::adjList(int node_id) const
+template<typename edge_type, typename edge_count_t>
+std::pmr::list<edge_type> const & Digraph<edge_type, edge_count_t>::adjList(node_id_type node_id) const
 {
     return (nodes[node_id]).neighbours;
 }
 
-template<typename edge_type>
-std::list<edge_type>& Digraph<edge_type>::adjList_ref(int node_id)
+template<typename edge_type, typename edge_count_t>
+std::pmr::list<edge_type>& Digraph<edge_type, edge_count_t>::adjList_ref(node_id_type node_id)
 {
+    in_edges.reset();
     return ((nodes[node_id]).neighbours);
 }
 
-template<typename edge_type>
-int Digraph<edge_type>::num_edges() const
+template<typename edge_type, typename edge_count_t>
+typename Digraph<edge_type, edge_count_t>::InEdgeRange Digraph<edge_type, edge_count_t>::inAdjList(node_id_type node_id) const
+{
+    index_in_edges();
+    return InEdgeRange((*in_edges)[node_id]);
+}
+
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::index_in_edges() const
+{
+    if (in_edges) {
+        return;
+    }
+    auto index = std::make_unique<std::vector<std::vector<edge_type const *>>>(num_nodes());
+    const auto indegs = indegrees();
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        (*index)[i].reserve(indegs[i]);
+    }
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        for (auto const & edge : nodes[i].neighbours) {
+            (*index)[edge.to].push_back(&edge);
+        }
+    }
+    in_edges = std::move(index);
+}
+
+template<typename edge_type, typename edge_count_t>
+typename Digraph<edge_type, edge_count_t>::edge_count_type Digraph<edge_type, edge_count_t>::num_edges() const
 {
     return edges;
 }
 
-template<typename edge_type>
-edge_type Digraph<edge_type>::min_ingoing_edge(int node_id) const requires IsWeighted<edge_type>
+template<typename edge_type, typename edge_count_t>
+edge_type Digraph<edge_type, edge_count_t>::min_ingoing_edge(node_id_type node_id) const requires IsWeighted<edge_type>
 {
     return mins[node_id];
 }
 
-template<typename edge_type>
-Digraph<edge_type> Digraph<edge_type>::contract_set(std::vector<int> const &v, std::vector<edge_type> &min_edges_in,
+template<typename edge_type, typename edge_count_t>
+Digraph<edge_type, edge_count_t> Digraph<edge_type, edge_count_t>::contract_set(std::vector<node_id_type> const &v, std::vector<edge_type> &min_edges_in,
     std::vector<edge_type> &min_edges_out) const
 {
     // min_edge_in and min_edge_out store the exact edges going into and out of the contracted set, preventing loss of info for Edmonds
-    Digraph<edge_type> digraph(num_nodes() - v.size() + 1);
-    int count = 0;
+    Digraph digraph(num_nodes() - v.size() + 1, external_resource());
+    node_id_type count = 0;
     // marking is interpreted here as being within the contracted set: this is to minimise computation
     std::vector<bool> marking(num_nodes(), false);
-    for (int i: v) {
+    for (node_id_type i: v) {
         marking[i] = true;
     }
     // want to store which nodes in the new graph the old nodes are mapped to
-    std::vector<int> mappedto(num_nodes());
-    for (int i = 0; i < num_nodes(); i++) {
+    std::vector<node_id_type> mappedto(num_nodes());
+    for (node_id_type i = 0; i < num_nodes(); i++) {
         if (!marking[i]) {
             digraph.name_node(count, i);
             mappedto[i] = count;
@@ -339,7 +620,7 @@ Digraph<edge_type> Digraph<edge_type>::contract_set(std::vector<int> const &v, s
         }
     }
     // now copy over all edges, treating the contracted set as a single vertex
-    for (int i = 0; i < num_nodes(); i++) {
+    for (node_id_type i = 0; i < num_nodes(); i++) {
         for (auto const & j: nodes[i].neighbours) {
             // ignore edges from the contracted set to itself
             // not that aesthetically pleasing but this breaks the find_cycle method if not done
@@ -358,33 +639,33 @@ Digraph<edge_type> Digraph<edge_type>::contract_set(std::vector<int> const &v, s
     return digraph;
 }
 
-template<typename edge_type>
-size_t Digraph<edge_type>::num_nodes() const
+template<typename edge_type, typename edge_count_t>
+size_t Digraph<edge_type, edge_count_t>::num_nodes() const
 {
     return nodes.size();
 }
 
-template<typename edge_type>
-Digraph<edge_type> Digraph<edge_type>::transpose() const
+template<typename edge_type, typename edge_count_t>
+Digraph<edge_type, edge_count_t> Digraph<edge_type, edge_count_t>::transpose() const
 {
-    Digraph G(num_nodes());
-    for (int i = 0; i < num_nodes(); i++) {
-        for (auto const &j: ((nodes[i]).neighbours)) {
+    Digraph G(num_nodes(), external_resource());
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        for (auto const &j: adjList(i)) {
             G.add_edge(j.to, j.from);
         }
     }
     return G;
 }
 
-template<typename edge_type>
-std::vector<edge_type> Digraph<edge_type>::find_cycle() const
+template<typename edge_type, typename edge_count_t>
+std::vector<edge_type> Digraph<edge_type, edge_count_t>::find_cycle() const
 {
     std::vector<bool> visited(num_nodes(), false);
     std::vector<bool> possible(num_nodes(), false);
     std::vector<edge_type> cycle;
     cycle.reserve(num_nodes());
 
-    for (int i = 0; i < num_nodes(); i++) {
+    for (node_id_type i = 0; i < num_nodes(); i++) {
         if (dfs(i, visited, possible, cycle)) {
             return cycle;
         }
@@ -396,13 +677,13 @@ std::vector<edge_type> Digraph<edge_type>::find_cycle() const
     return {};
 }
 
-template<typename edge_type>
-bool Digraph<edge_type>::dfs(int v, std::vector<bool> &visited, std::vector<bool> &possible,
+template<typename edge_type, typename edge_count_t>
+bool Digraph<edge_type, edge_count_t>::dfs(node_id_type v, std::vector<bool> &visited, std::vector<bool> &possible,
     std::vector<edge_type> &cycle) const
 {
     visited[v] = true;
     possible[v] = true;
-    for (auto outgoing_edge : adjList(v)) {
+    for (auto const & outgoing_edge : adjList(v)) {
         if(!visited[outgoing_edge.to]) {
             cycle.emplace_back(outgoing_edge);
             if (dfs(outgoing_edge.to, visited, possible, cycle)) {
@@ -429,11 +710,11 @@ bool Digraph<edge_type>::dfs(int v, std::vector<bool> &visited, std::vector<bool
 }
 
 
-template<typename edge_type>
-Digraph<edge_type> Digraph<edge_type>::modified_weights() const requires IsWeighted<edge_type>
+template<typename edge_type, typename edge_count_t>
+Digraph<edge_type, edge_count_t> Digraph<edge_type, edge_count_t>::modified_weights() const requires IsWeighted<edge_type>
 {
-    Digraph H(num_nodes());
-    for (int i = 0; i < num_nodes(); i++) {
+    Digraph H(num_nodes(), external_resource());
+    for (node_id_type i = 0; i < num_nodes(); i++) {
         H.name_node(i, node_name(i));
         for (auto const & outgoing_edge : adjList(i)) {
             H.add_edge(outgoing_edge.from, outgoing_edge.to, outgoing_edge.weight - mins[outgoing_edge.to].weight);
@@ -442,23 +723,23 @@ Digraph<edge_type> Digraph<edge_type>::modified_weights() const requires IsWeigh
     return H;
 }
 
-template<typename edge_type>
-void Digraph<edge_type>::name_node(int node_id, int new_name)
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::name_node(node_id_type node_id, node_id_type new_name)
 {
     nodes[node_id].give_name(new_name);
 }
 
-template<typename edge_type>
-int Digraph<edge_type>::node_name(int node_id)
+template<typename edge_type, typename edge_count_t>
+typename Digraph<edge_type, edge_count_t>::node_id_type Digraph<edge_type, edge_count_t>::node_name(node_id_type node_id)
 {
     return nodes[node_id].name;
 }
 
-template<typename edge_type>
-Digraph<Edge> Digraph<edge_type>::lose_weight() const requires IsWeighted<edge_type>
+template<typename edge_type, typename edge_count_t>
+Digraph<BasicEdge<typename edge_type::node_id_type>, edge_count_t> Digraph<edge_type, edge_count_t>::lose_weight() const requires IsWeighted<edge_type>
 {
-    Digraph<Edge> H(num_nodes());
-    for (int i = 0; i < num_nodes(); i++) {
+    Digraph<BasicEdge<node_id_type>, edge_count_t> H(num_nodes(), external_resource());
+    for (node_id_type i = 0; i < num_nodes(); i++) {
         for (auto const & edge : adjList(i)) {
             H.add_edge(edge.from, edge.to);
         }
@@ -466,25 +747,25 @@ Digraph<Edge> Digraph<edge_type>::lose_weight() const requires IsWeighted<edge_t
     return H;
 }
 
-template<typename edge_type>
-Digraph<edge_type> Digraph<edge_type>::remove_parallel_min() const requires IsWeighted<edge_type>
+template<typename edge_type, typename edge_count_t>
+Digraph<edge_type, edge_count_t> Digraph<edge_type, edge_count_t>::remove_parallel_min() const requires IsWeighted<edge_type>
 {
-    Digraph H(num_nodes());
-    std::vector<double> weights(num_nodes(), std::numeric_limits<weight_type>::max());
+    Digraph H(num_nodes(), external_resource());
+    std::vector<weight_type> weights(num_nodes(), std::numeric_limits<weight_type>::max());
     //store minimum weight pointing from i to every other node
     // initialising first and resetting by hand guarantees O(m) runtime
-    for (int i = 0; i < num_nodes(); i++) {
-        for (auto edge: adjList(i)) {
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        for (auto const & edge: adjList(i)) {
             if (weights[edge.to] > edge.weight) {
                 weights[edge.to] = edge.weight;
             }
         }
-        for (int j = 0; j < num_nodes(); j++) {
+        for (node_id_type j = 0; j < num_nodes(); j++) {
             if (weights[j] < std::numeric_limits<weight_type>::max()) {
                 H.add_edge(i, j, weights[j]);
             }
         }
-        for (auto edge: adjList(i)) {
+        for (auto const & edge: adjList(i)) {
             weights[edge.to] = std::numeric_limits<weight_type>::max();
         }
     }
@@ -492,19 +773,19 @@ Digraph<edge_type> Digraph<edge_type>::remove_parallel_min() const requires IsWe
     return H;
 }
 
-template<typename edge_type>
-Digraph<edge_type> Digraph<edge_type>::remove_parallel() const
+template<typename edge_type, typename edge_count_t>
+Digraph<edge_type, edge_count_t> Digraph<edge_type, edge_count_t>::remove_parallel() const
 {
-    Digraph H(num_nodes());
+    Digraph H(num_nodes(), external_resource());
     std::vector<bool> visited(num_nodes(),false);
-    for (int i = 0; i < num_nodes(); i++) {
-        for (auto edge : adjList(i)) {
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        for (auto const & edge : adjList(i)) {
             if (!visited[edge.to]) {
                 visited[edge.to] = true;
                 H.add_edge(edge);
             }
         }
-        for (auto edge : adjList(i)) {
+        for (auto const & edge : adjList(i)) {
             visited[edge.to] = false;
         }
     }
@@ -512,75 +793,538 @@ Digraph<edge_type> Digraph<edge_type>::remove_parallel() const
 }
 
 
-template<typename edge_type>
-void Digraph<edge_type>::double_edges()
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::double_edges()
 {
-    for (int i = 0; i < num_nodes(); i++) {
-        for (auto edge: adjList(i)) {
-            int x = edge.to;
-            edge.to = edge.from;
-            edge.from = x;
+    // only reverse the edges present before the call: the reversed copies are appended to the back of the lists
+    std::vector<edge_count_type> original_outdeg(num_nodes());
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        original_outdeg[i] = outdeg(i);
+    }
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        auto itr = adjList(i).begin();
+        for (edge_count_type k = 0; k < original_outdeg[i]; k++, ++itr) {
+            edge_type edge = *itr;
+            std::swap(edge.from, edge.to);
             add_edge(edge);
         }
     }
 }
 
-template<typename edge_type>
-bool Digraph<edge_type>::isEdge(int from, int to) const
+template<typename edge_type, typename edge_count_t>
+bool Digraph<edge_type, edge_count_t>::isEdge(node_id_type from, node_id_type to) const
 {
-    return (std::find(adjList(from).begin(), adjList(from).end(), to) != adjList(from).end());
+    return std::any_of(adjList(from).begin(), adjList(from).end(), [to](edge_type const & edge) { return edge.to == to; });
 }
 
-template<typename edge_type>
-int Digraph<edge_type>::outdeg(int node_id) const
+template<typename edge_type, typename edge_count_t>
+typename Digraph<edge_type, edge_count_t>::edge_count_type Digraph<edge_type, edge_count_t>::outdeg(node_id_type node_id) const
 {
     return nodes[node_id].outdeg();
 }
 
-template<typename edge_type>
-typename Digraph<edge_type>::weight_type Digraph<edge_type>::get_max() const
+template<typename edge_type, typename edge_count_t>
+typename Digraph<edge_type, edge_count_t>::weight_type Digraph<edge_type, edge_count_t>::get_max() const
 {
     return max;
 }
 
 
-template<typename edge_type>
-std::vector<int> Digraph<edge_type>::indegrees() const
+template<typename edge_type, typename edge_count_t>
+std::vector<typename Digraph<edge_type, edge_count_t>::edge_count_type> Digraph<edge_type, edge_count_t>::indegrees() const
 {
-    std::vector<int> indegs(num_nodes(), 0);
-    for (int i = 0; i < num_nodes(); i++) {
-        for (auto const &j: ((nodes[i]).neighbours)) {
+    std::vector<edge_count_type> indegs(num_nodes(), 0);
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        for (auto const &j: adjList(i)) {
             ++indegs[j.to];
         }
     }
     return indegs;
 }
 
-template<typename edge_type>
-edge_type Digraph<edge_type>::pop_edge(int node_id)
+template<typename edge_type, typename edge_count_t>
+edge_type Digraph<edge_type, edge_count_t>::pop_edge(node_id_type node_id)
 {
-    const edge_type result = adjList(node_id).front();
+    const edge_type result = nodes[node_id].neighbours.front();
+    if (in_edges) {
+        auto & into = (*in_edges)[result.to];
+        into.erase(std::find(into.begin(), into.end(), &nodes[node_id].neighbours.front()));
+    }
     (nodes[node_id].neighbours).pop_front();
     return result;
 }
 
-template<typename edge_type>
-void Digraph<edge_type>::mark() requires HasMarking<edge_type>
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::mark() requires HasMarking<edge_type>
 {
-    for (int i = 0; i < num_nodes(); i++) {
-        for (auto const & edge : adjList(i)) {
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        for (auto & edge : nodes[i].neighbours) {
             edge.mark();
         }
     }
 }
 
-template<typename edge_type>
-void Digraph<edge_type>::unmark() requires HasMarking<edge_type>
+template<typename edge_type, typename edge_count_t>
+void Digraph<edge_type, edge_count_t>::unmark() requires HasMarking<edge_type>
 {
-    for (int i = 0; i < num_nodes(); i++) {
-        for (auto & edge : adjList(i)) {
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        for (auto & edge : nodes[i].neighbours) {
             edge.unmark();
         }
     }
 }
+
+// Immutable digraph in compressed sparse row form. The out-edges of node i are stored contiguously:
+// their targets are targets[offsets[i]], ..., targets[offsets[i+1]-1] and their weights sit at the same positions
+// of weights. Iterating over adjList(i) yields edge_type objects built on the fly, so algorithms written for
+// Digraph run on it unchanged.
+// The arrays are never modified after construction, so copies share them. They are either owned by the graph
+// or live in external memory such as a mapped file, which is kept alive through storage.
+// edge_index_t is the type of the offsets, it has to be able to hold the number of edges.
+template<typename edge_type, typename edge_index_t = int> requires (!HasFlow<edge_type>)
+class CSRDigraph
+{
+public:
+    using weight_type = typename edge_type::weight_type;
+    using node_id_type = typename edge_type::node_id_type;
+    using edge_count_type = edge_index_t;
+
+    class EdgeIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = edge_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = edge_type;
+
+        EdgeIterator() = default;
+        EdgeIterator(CSRDigraph const * graph, node_id_type from, edge_index_t pos) : graph(graph), from(from), pos(pos) {}
+
+        edge_type operator*() const
+        {
+            return graph->make_edge(from, pos);
+        }
+
+        EdgeIterator & operator++()
+        {
+            ++pos;
+            return *this;
+        }
+
+        EdgeIterator operator++(int)
+        {
+            EdgeIterator old = *this;
+            ++pos;
+            return old;
+        }
+
+        bool operator==(EdgeIterator const & other) const
+        {
+            return pos == other.pos;
+        }
+
+    private:
+        CSRDigraph const * graph = nullptr;
+        node_id_type from = 0;
+        edge_index_t pos = 0;
+    };
+
+    class EdgeRange
+    {
+    public:
+        EdgeRange(CSRDigraph const * graph, node_id_type from) : graph(graph), from(from) {}
+        EdgeIterator begin() const { return EdgeIterator(graph, from, graph->offsets[from]); }
+        EdgeIterator end() const { return EdgeIterator(graph, from, graph->offsets[from + 1]); }
+        edge_index_t size() const { return graph->offsets[from + 1] - graph->offsets[from]; }
+        bool empty() const { return size() == 0; }
+
+    private:
+        CSRDigraph const * graph;
+        node_id_type from;
+    };
+
+    // the edges into a node are listed by the position of each edge in the forward arrays
+    struct ReverseIndex
+    {
+        std::vector<edge_index_t> offsets;
+        std::vector<node_id_type> sources;
+        std::vector<edge_index_t> positions;
+    };
+
+    class InEdgeIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = edge_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = edge_type;
+
+        InEdgeIterator() = default;
+        InEdgeIterator(CSRDigraph const * graph, edge_index_t pos) : graph(graph), pos(pos) {}
+
+        edge_type operator*() const
+        {
+            return graph->make_edge(graph->reverse->sources[pos], graph->reverse->positions[pos]);
+        }
+
+        InEdgeIterator & operator++()
+        {
+            ++pos;
+            return *this;
+        }
+
+        InEdgeIterator operator++(int)
+        {
+            InEdgeIterator old = *this;
+            ++pos;
+            return old;
+        }
+
+        bool operator==(InEdgeIterator const & other) const
+        {
+            return pos == other.pos;
+        }
+
+    private:
+        CSRDigraph const * graph = nullptr;
+        edge_index_t pos = 0;
+    };
+
+    class InEdgeRange
+    {
+    public:
+        InEdgeRange(CSRDigraph const * graph, node_id_type to) : graph(graph), to(to) {}
+        InEdgeIterator begin() const { return InEdgeIterator(graph, graph->reverse->offsets[to]); }
+        InEdgeIterator end() const { return InEdgeIterator(graph, graph->reverse->offsets[to + 1]); }
+        edge_index_t size() const { return graph->reverse->offsets[to + 1] - graph->reverse->offsets[to]; }
+        bool empty() const { return size() == 0; }
+
+    private:
+        CSRDigraph const * graph;
+        node_id_type to;
+    };
+
+    template<typename edge_count_t>
+    explicit CSRDigraph(Digraph<edge_type, edge_count_t> const & G);
+
+    // the edges may be given in any order, they are bucketed by their from node.
+    // node_names gives every node a name as Digraph::name_node does, all nodes are named 0 if it is empty.
+    CSRDigraph(size_t num_nodes, std::vector<edge_type> const & edge_list, std::vector<node_id_type> node_names = {});
+
+    // wraps arrays that live elsewhere, storage has to keep them alive. weights is ignored for unweighted edges
+    // and names may be empty, in which case every node is named 0 as in a fresh Digraph.
+    CSRDigraph(std::shared_ptr<const void> storage, std::span<const edge_index_t> offsets, std::span<const node_id_type> targets,
+        std::span<const weight_type> weights, std::span<const node_id_type> names, weight_type max);
+
+    size_t num_nodes() const;
+
+    edge_index_t num_edges() const;
+
+    edge_index_t outdeg(node_id_type node_id) const;
+
+    EdgeRange adjList(node_id_type node_id) const;
+
+    // the edges into node_id. The reverse index behind this is built on the first call, copies made afterwards share it.
+    // Building it is not thread-safe: call index_in_edges() before sharing the graph between threads.
+    InEdgeRange inAdjList(node_id_type node_id) const;
+
+    void index_in_edges() const;
+
+    node_id_type node_name(node_id_type node_id) const;
+
+    std::vector<edge_index_t> indegrees() const;
+
+    CSRDigraph transpose() const;
+
+    weight_type get_max() const;
+
+    // raw access to the underlying arrays, e.g. for serialisation
+    std::span<const edge_index_t> offset_array() const;
+
+    std::span<const node_id_type> target_array() const;
+
+    std::span<const weight_type> weight_array() const requires IsWeighted<edge_type>;
+
+    std::span<const node_id_type> name_array() const;
+
+private:
+    struct OwnedArrays
+    {
+        std::vector<edge_index_t> offsets;
+        std::vector<node_id_type> targets;
+        std::vector<weight_type> weights;
+        std::vector<node_id_type> names;
+    };
+
+    std::shared_ptr<const void> storage;
+    std::span<const edge_index_t> offsets;
+    std::span<const node_id_type> targets;
+    std::span<const weight_type> weights;
+    std::span<const node_id_type> names;
+    weight_type max;
+    mutable std::shared_ptr<const ReverseIndex> reverse;
+
+    void adopt(std::shared_ptr<OwnedArrays> arrays, weight_type max_weight);
+    edge_type make_edge(node_id_type from, edge_index_t pos) const;
+};
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+template<typename edge_count_t>
+CSRDigraph<edge_type, edge_index_t>::CSRDigraph(Digraph<edge_type, edge_count_t> const & G)
+{
+    check_edge_count<edge_index_t>(G.num_edges());
+    auto arrays = std::make_shared<OwnedArrays>();
+    arrays->offsets.resize(G.num_nodes() + 1);
+    arrays->names.resize(G.num_nodes());
+    arrays->targets.reserve(G.num_edges());
+    if constexpr (IsWeighted<edge_type>) {
+        arrays->weights.reserve(G.num_edges());
+    }
+    arrays->offsets[0] = 0;
+    for (node_id_type i = 0; i < G.num_nodes(); i++) {
+        for (auto const & edge : G.adjList(i)) {
+            arrays->targets.push_back(edge.to);
+            if constexpr (IsWeighted<edge_type>) {
+                arrays->weights.push_back(edge.weight);
+            }
+        }
+        arrays->offsets[i + 1] = arrays->targets.size();
+        arrays->names[i] = G.node_name(i);
+    }
+    adopt(std::move(arrays), G.get_max());
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+CSRDigraph<edge_type, edge_index_t>::CSRDigraph(size_t num_nodes, std::vector<edge_type> const & edge_list, std::vector<node_id_type> node_names)
+{
+    check_node_count<node_id_type>(num_nodes);
+    check_edge_count<edge_index_t>(edge_list.size());
+    auto arrays = std::make_shared<OwnedArrays>();
+    std::vector<edge_index_t> & offs = arrays->offsets;
+    offs.assign(num_nodes + 1, 0);
+    arrays->targets.resize(edge_list.size());
+    arrays->names = std::move(node_names);
+    arrays->names.resize(num_nodes, 0);
+    weight_type max_weight = 0;
+    // counting sort by from node: first count the outdegrees, then turn them into offsets and place every edge
+    for (auto const & edge : edge_list) {
+        ++offs[edge.from + 1];
+    }
+    for (size_t i = 0; i < num_nodes; i++) {
+        offs[i + 1] += offs[i];
+    }
+    if constexpr (IsWeighted<edge_type>) {
+        arrays->weights.resize(edge_list.size());
+        max_weight = std::numeric_limits<weight_type>::lowest();
+    }
+    std::vector<edge_index_t> next(offs.begin(), offs.end() - 1);
+    for (auto const & edge : edge_list) {
+        const edge_index_t pos = next[edge.from]++;
+        arrays->targets[pos] = edge.to;
+        if constexpr (IsWeighted<edge_type>) {
+            arrays->weights[pos] = edge.weight;
+            if (edge.weight > max_weight) {
+                max_weight = edge.weight;
+            }
+        }
+    }
+    adopt(std::move(arrays), max_weight);
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+CSRDigraph<edge_type, edge_index_t>::CSRDigraph(std::shared_ptr<const void> storage, std::span<const edge_index_t> offsets, std::span<const node_id_type> targets,
+    std::span<const weight_type> weights, std::span<const node_id_type> names, weight_type max)
+    : storage(std::move(storage)), offsets(offsets), targets(targets), weights(weights), names(names), max(max)
+{
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+void CSRDigraph<edge_type, edge_index_t>::adopt(std::shared_ptr<OwnedArrays> arrays, weight_type max_weight)
+{
+    offsets = arrays->offsets;
+    targets = arrays->targets;
+    if constexpr (IsWeighted<edge_type>) {
+        weights = arrays->weights;
+    }
+    names = arrays->names;
+    max = max_weight;
+    storage = std::move(arrays);
+    // an index built for the previous arrays describes a different graph
+    reverse.reset();
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+size_t CSRDigraph<edge_type, edge_index_t>::num_nodes() const
+{
+    return offsets.size() - 1;
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+edge_index_t CSRDigraph<edge_type, edge_index_t>::num_edges() const
+{
+    return targets.size();
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+edge_index_t CSRDigraph<edge_type, edge_index_t>::outdeg(node_id_type node_id) const
+{
+    return offsets[node_id + 1] - offsets[node_id];
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+typename CSRDigraph<edge_type, edge_index_t>::EdgeRange CSRDigraph<edge_type, edge_index_t>::adjList(node_id_type node_id) const
+{
+    return EdgeRange(this, node_id);
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+typename CSRDigraph<edge_type, edge_index_t>::InEdgeRange CSRDigraph<edge_type, edge_index_t>::inAdjList(node_id_type node_id) const
+{
+    index_in_edges();
+    return InEdgeRange(this, node_id);
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+void CSRDigraph<edge_type, edge_index_t>::index_in_edges() const
+{
+    if (reverse) {
+        return;
+    }
+    // counting sort of the edge positions by target
+    auto index = std::make_shared<ReverseIndex>();
+    index->offsets.assign(num_nodes() + 1, 0);
+    index->sources.resize(num_edges());
+    index->positions.resize(num_edges());
+    for (const node_id_type to : targets) {
+        ++index->offsets[to + 1];
+    }
+    for (size_t i = 0; i < num_nodes(); i++) {
+        index->offsets[i + 1] += index->offsets[i];
+    }
+    std::vector<edge_index_t> next(index->offsets.begin(), index->offsets.end() - 1);
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        for (edge_index_t pos = offsets[i]; pos < offsets[i + 1]; pos++) {
+            const edge_index_t slot = next[targets[pos]]++;
+            index->sources[slot] = i;
+            index->positions[slot] = pos;
+        }
+    }
+    reverse = std::move(index);
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+typename CSRDigraph<edge_type, edge_index_t>::node_id_type CSRDigraph<edge_type, edge_index_t>::node_name(node_id_type node_id) const
+{
+    return names.empty() ? 0 : names[node_id];
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+std::vector<edge_index_t> CSRDigraph<edge_type, edge_index_t>::indegrees() const
+{
+    std::vector<edge_index_t> indegs(num_nodes(), 0);
+    for (const node_id_type to : targets) {
+        ++indegs[to];
+    }
+    return indegs;
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+CSRDigraph<edge_type, edge_index_t> CSRDigraph<edge_type, edge_index_t>::transpose() const
+{
+    // counting sort by target, keeping the weights with their edges
+    auto arrays = std::make_shared<OwnedArrays>();
+    std::vector<edge_index_t> & offs = arrays->offsets;
+    offs.assign(num_nodes() + 1, 0);
+    arrays->targets.resize(num_edges());
+    arrays->names.assign(names.begin(), names.end());
+    for (const node_id_type to : targets) {
+        ++offs[to + 1];
+    }
+    for (size_t i = 0; i < num_nodes(); i++) {
+        offs[i + 1] += offs[i];
+    }
+    if constexpr (IsWeighted<edge_type>) {
+        arrays->weights.resize(num_edges());
+    }
+    std::vector<edge_index_t> next(offs.begin(), offs.end() - 1);
+    for (node_id_type i = 0; i < num_nodes(); i++) {
+        for (edge_index_t pos = offsets[i]; pos < offsets[i + 1]; pos++) {
+            const edge_index_t new_pos = next[targets[pos]]++;
+            arrays->targets[new_pos] = i;
+            if constexpr (IsWeighted<edge_type>) {
+                arrays->weights[new_pos] = weights[pos];
+            }
+        }
+    }
+    CSRDigraph T(*this);
+    T.adopt(std::move(arrays), max);
+    return T;
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+typename CSRDigraph<edge_type, edge_index_t>::weight_type CSRDigraph<edge_type, edge_index_t>::get_max() const
+{
+    return max;
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+std::span<const edge_index_t> CSRDigraph<edge_type, edge_index_t>::offset_array() const
+{
+    return offsets;
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+std::span<const typename CSRDigraph<edge_type, edge_index_t>::node_id_type> CSRDigraph<edge_type, edge_index_t>::target_array() const
+{
+    return targets;
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+std::span<const typename CSRDigraph<edge_type, edge_index_t>::weight_type> CSRDigraph<edge_type, edge_index_t>::weight_array() const requires IsWeighted<edge_type>
+{
+    return weights;
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+std::span<const typename CSRDigraph<edge_type, edge_index_t>::node_id_type> CSRDigraph<edge_type, edge_index_t>::name_array() const
+{
+    return names;
+}
+
+template<typename edge_type, typename edge_index_t> requires (!HasFlow<edge_type>)
+edge_type CSRDigraph<edge_type, edge_index_t>::make_edge(node_id_type from, edge_index_t pos) const
+{
+    if constexpr (IsWeighted<edge_type>) {
+        return edge_type(from, targets[pos], weights[pos]);
+    }
+    else {
+        return edge_type(from, targets[pos]);
+    }
+}
+
+// 32 and 64 bit variants of the graph types. The 32 bit ones take half the memory and bandwidth, the 64 bit ones
+// are needed once there are more than 2^31 nodes or edges.
+using Edge32 = BasicEdge<int32_t>;
+using Edge64 = BasicEdge<int64_t>;
+
+template<typename weight_t>
+using WeightedEdge32 = WeightedEdge<weight_t, int32_t>;
+
+template<typename weight_t>
+using WeightedEdge64 = WeightedEdge<weight_t, int64_t>;
+
+template<typename edge_type>
+using Digraph32 = Digraph<edge_type, int32_t>;
+
+template<typename edge_type>
+using Digraph64 = Digraph<edge_type, int64_t>;
+
+template<typename edge_type>
+using CSRDigraph32 = CSRDigraph<edge_type, int32_t>;
+
+template<typename edge_type>
+using CSRDigraph64 = CSRDigraph<edge_type, int64_t>;
+
 #endif //C___DIGRAPH_H
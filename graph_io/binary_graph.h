@@ -0,0 +1,248 @@
+// Versioned binary file format for CSRDigraph and a loader that maps such a file into memory.
+// The mapped graph points straight into the file, so loading costs no parsing, only one pass that checks the arrays
+// and the page faults it causes.
+// Author: Georgi Kocharyan
+
+#ifndef GRAPH_IO_BINARY_GRAPH_H
+#define GRAPH_IO_BINARY_GRAPH_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "digraph.h"
+
+// Layout of a file, all values in native byte order:
+//   BinaryGraphHeader
+//   offsets  (num_nodes + 1 edge indices)
+//   targets  (num_edges node ids)
+//   weights  (num_edges weights, only if flags & binary_graph_weighted)
+//   names    (num_nodes node ids, only if flags & binary_graph_named)
+// every array starts at a multiple of binary_graph_alignment so that it can be used in place.
+// Version 1 files always have int node ids and offsets, and store sizeof(int) in id_code and 0 in offset_code.
+
+constexpr char binary_graph_magic[8] = {'G', 'R', 'A', 'P', 'H', 'B', 'I', 'N'};
+constexpr uint32_t binary_graph_version = 2;
+constexpr uint32_t binary_graph_byte_order = 0x01020304;
+constexpr size_t binary_graph_alignment = 64;
+constexpr uint32_t binary_graph_weighted = 1;
+constexpr uint32_t binary_graph_named = 2;
+
+struct BinaryGraphHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t flags;
+    uint32_t weight_code; // identifies the weight type, see binary_type_code
+    uint32_t id_code; // type of the node ids
+    uint32_t offset_code; // type of the entries of offsets
+    uint64_t num_nodes;
+    uint64_t num_edges;
+    unsigned char max_weight[8]; // get_max() of the graph, stored bitwise
+};
+
+static_assert(sizeof(BinaryGraphHeader) == 56);
+
+template<typename number_type>
+constexpr uint32_t binary_type_code()
+{
+    // kind of number in the upper byte, size in the lower one
+    if constexpr (std::is_same_v<number_type, bool>) {
+        return 0;
+    }
+    else if constexpr (std::is_floating_point_v<number_type>) {
+        return 0x100 | sizeof(number_type);
+    }
+    else if constexpr (std::is_signed_v<number_type>) {
+        return 0x200 | sizeof(number_type);
+    }
+    else {
+        return 0x300 | sizeof(number_type);
+    }
+}
+
+inline size_t binary_graph_align(size_t position)
+{
+    return (position + binary_graph_alignment - 1) / binary_graph_alignment * binary_graph_alignment;
+}
+
+template<typename edge_type, typename edge_index_t>
+void write_binary_graph(CSRDigraph<edge_type, edge_index_t> const & G, std::string const & path, bool with_names = true)
+{
+    using weight_type = typename edge_type::weight_type;
+    using node_id_type = typename edge_type::node_id_type;
+    static_assert(sizeof(weight_type) <= 8);
+
+    BinaryGraphHeader header{};
+    std::memcpy(header.magic, binary_graph_magic, sizeof(header.magic));
+    header.version = binary_graph_version;
+    header.byte_order = binary_graph_byte_order;
+    header.flags = (IsWeighted<edge_type> ? binary_graph_weighted : 0u) | (with_names ? binary_graph_named : 0u);
+    header.weight_code = binary_type_code<weight_type>();
+    header.id_code = binary_type_code<node_id_type>();
+    header.offset_code = binary_type_code<edge_index_t>();
+    header.num_nodes = G.num_nodes();
+    header.num_edges = G.num_edges();
+    const weight_type max = G.get_max();
+    std::memcpy(header.max_weight, &max, sizeof(weight_type));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("cannot open " + path + " for writing");
+    }
+    size_t position = 0;
+    auto write_array = [&](auto const * data, size_t count) {
+        // pad up to the next aligned position first
+        static constexpr char zeros[binary_graph_alignment] = {};
+        const size_t start = binary_graph_align(position);
+        out.write(zeros, static_cast<std::streamsize>(start - position));
+        out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(*data)));
+        position = start + count * sizeof(*data);
+    };
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    position = sizeof(header);
+    write_array(G.offset_array().data(), G.num_nodes() + 1);
+    write_array(G.target_array().data(), G.num_edges());
+    if constexpr (IsWeighted<edge_type>) {
+        write_array(G.weight_array().data(), G.num_edges());
+    }
+    if (with_names) {
+        std::vector<node_id_type> names(G.num_nodes());
+        for (size_t i = 0; i < G.num_nodes(); i++) {
+            names[i] = G.node_name(static_cast<node_id_type>(i));
+        }
+        write_array(names.data(), names.size());
+    }
+    if (!out) {
+        throw std::runtime_error("error while writing " + path);
+    }
+}
+
+namespace binary_graph_detail
+{
+    // throws unless the arrays describe a graph every algorithm can run on: offsets rise from 0 to the number of edges,
+    // every target is a node and no weight exceeds max
+    template<typename edge_index_t, typename node_id_type, typename weight_type>
+    void validate(std::string const & path, std::span<const edge_index_t> offsets, std::span<const node_id_type> targets,
+        std::span<const weight_type> weights, weight_type max)
+    {
+        const size_t num_nodes = offsets.size() - 1;
+        if (offsets.front() != 0 || static_cast<size_t>(offsets.back()) != targets.size()) {
+            throw std::runtime_error(path + " has offsets that do not span its edges");
+        }
+        for (size_t i = 0; i < num_nodes; i++) {
+            if (offsets[i + 1] < offsets[i]) {
+                throw std::runtime_error(path + " has decreasing offsets at node " + std::to_string(i));
+            }
+        }
+        for (const node_id_type target : targets) {
+            bool negative = false;
+            if constexpr (std::is_signed_v<node_id_type>) {
+                negative = target < 0;
+            }
+            if (negative || static_cast<size_t>(target) >= num_nodes) {
+                throw std::runtime_error(path + " has an edge to node " + std::to_string(target) + ", which does not exist");
+            }
+        }
+        for (const weight_type weight : weights) {
+            if (weight > max) {
+                throw std::runtime_error(path + " has a weight above the maximum in its header");
+            }
+        }
+    }
+}
+
+// maps the file read-only into memory. The returned graph, and every copy of it, keeps the mapping alive. Every array of
+// the file is checked once, in O(n + m), so that a corrupt or truncated file is rejected here instead of sending the
+// algorithms out of bounds.
+template<typename edge_type, typename edge_index_t = int>
+CSRDigraph<edge_type, edge_index_t> map_binary_graph(std::string const & path)
+{
+    using weight_type = typename edge_type::weight_type;
+    using node_id_type = typename edge_type::node_id_type;
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BinaryGraphHeader))) {
+        close(fd);
+        throw std::runtime_error(path + " is not a binary graph file");
+    }
+    const size_t size = info.st_size;
+    void * address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after closing the descriptor
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("cannot map " + path);
+    }
+    std::shared_ptr<const void> mapping(address, [size](const void * p) { munmap(const_cast<void *>(p), size); });
+
+    const auto * bytes = static_cast<const char *>(address);
+    BinaryGraphHeader header{};
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, binary_graph_magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path + " is not a binary graph file");
+    }
+    if (header.version == 0 || header.version > binary_graph_version) {
+        throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.version));
+    }
+    if (header.byte_order != binary_graph_byte_order) {
+        throw std::runtime_error(path + " was written on an incompatible platform");
+    }
+    if (header.version == 1) {
+        header.id_code = header.id_code == sizeof(int) ? binary_type_code<int>() : 0;
+        header.offset_code = binary_type_code<int>();
+    }
+    if (((header.flags & binary_graph_weighted) != 0) != IsWeighted<edge_type> || header.weight_code != binary_type_code<weight_type>()) {
+        throw std::runtime_error(path + " does not hold edges of the requested type");
+    }
+    if (header.id_code != binary_type_code<node_id_type>() || header.offset_code != binary_type_code<edge_index_t>()) {
+        throw std::runtime_error(path + " uses other node id or edge index types than requested");
+    }
+    // the node count has to fit the id type, and the counts below cannot overflow
+    if (header.num_nodes > static_cast<uint64_t>(std::numeric_limits<node_id_type>::max())
+        || header.num_edges > static_cast<uint64_t>(std::numeric_limits<edge_index_t>::max())) {
+        throw std::runtime_error(path + " has more nodes or edges than its types can count");
+    }
+
+    size_t position = sizeof(header);
+    auto next_array = [&]<typename T>(size_t count) {
+        const size_t start = binary_graph_align(position);
+        if (start > size || count > (size - start) / sizeof(T)) {
+            throw std::runtime_error(path + " is truncated");
+        }
+        position = start + count * sizeof(T);
+        return std::span<const T>(reinterpret_cast<const T *>(bytes + start), count);
+    };
+    const auto offsets = next_array.template operator()<edge_index_t>(header.num_nodes + 1);
+    const auto targets = next_array.template operator()<node_id_type>(header.num_edges);
+    std::span<const weight_type> weights;
+    if constexpr (IsWeighted<edge_type>) {
+        weights = next_array.template operator()<weight_type>(header.num_edges);
+    }
+    std::span<const node_id_type> names;
+    if (header.flags & binary_graph_named) {
+        names = next_array.template operator()<node_id_type>(header.num_nodes);
+    }
+    weight_type max;
+    std::memcpy(&max, header.max_weight, sizeof(weight_type));
+    binary_graph_detail::validate(path, offsets, targets, weights, max);
+
+    return CSRDigraph<edge_type, edge_index_t>(std::move(mapping), offsets, targets, weights, names, max);
+}
+
+#endif //GRAPH_IO_BINARY_GRAPH_H
@@ -0,0 +1,561 @@
+// Parallel reader for graphs given as text in DIMACS (shortest path and max flow), SNAP edge list or METIS format.
+// Files are mapped and cut into one chunk per thread at line boundaries; standard input is consumed in large
+// blocks, each of which is parsed in parallel while the next one is being read.
+// Author: Georgi Kocharyan
+
+#ifndef GRAPH_IO_EDGE_LIST_READER_H
+#define GRAPH_IO_EDGE_LIST_READER_H
+
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "digraph.h"
+
+enum class GraphFormat
+{
+    dimacs, // "p sp n m" header, arcs "a u v w", nodes numbered from 1
+    dimacs_flow, // "p max n m" header, "n id s" / "n id t" for source and sink, arcs "a u v capacity"
+    snap, // "u v" or "u v w" per line, "#" starts a comment, nodes numbered from 0
+    metis // header "n m [fmt [ncon]]", then line i lists the neighbours of node i, nodes numbered from 1
+};
+
+inline GraphFormat parse_graph_format(std::string const & name)
+{
+    if (name == "dimacs") {
+        return GraphFormat::dimacs;
+    }
+    if (name == "dimacs-flow") {
+        return GraphFormat::dimacs_flow;
+    }
+    if (name == "snap") {
+        return GraphFormat::snap;
+    }
+    if (name == "metis") {
+        return GraphFormat::metis;
+    }
+    throw std::invalid_argument("unknown graph format " + name + " (expected dimacs, dimacs-flow, snap or metis)");
+}
+
+// the edges in the order they appear in the input. Unweighted inputs get weight 1 on every edge.
+// node_id_type has to hold the number of nodes, so reading fails on node ids from its maximum up.
+template<typename weight_type, typename node_id_type = int>
+struct EdgeListFile
+{
+    size_t num_nodes = 0;
+    std::vector<WeightedEdge<weight_type, node_id_type>> edges;
+    std::optional<node_id_type> source; // only set by dimacs_flow
+    std::optional<node_id_type> sink;
+};
+
+namespace edge_list_detail
+{
+    // METIS files have a header fixing the meaning of every line, all other formats are line independent
+    struct MetisLayout
+    {
+        size_t num_nodes = 0;
+        int skipped_values = 0; // vertex sizes and vertex weights preceding the neighbours
+        bool edge_weights = false;
+    };
+
+    template<typename weight_type, typename node_id_type>
+    struct ChunkResult
+    {
+        std::vector<WeightedEdge<weight_type, node_id_type>> edges;
+        size_t declared_nodes = 0;
+        size_t max_node = 0;
+        bool any_node = false;
+        std::optional<node_id_type> source;
+        std::optional<node_id_type> sink;
+        // the lines source and sink were read from, for the error message
+        const char * source_line = nullptr;
+        const char * sink_line = nullptr;
+        std::exception_ptr error;
+    };
+
+    inline const char * skip_blanks(const char * pos, const char * end)
+    {
+        while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) {
+            ++pos;
+        }
+        return pos;
+    }
+
+    template<typename number_type>
+    bool read_number(const char * & pos, const char * end, number_type & value)
+    {
+        pos = skip_blanks(pos, end);
+        if (pos < end && *pos == '+') {
+            ++pos;
+        }
+        const auto [ptr, ec] = std::from_chars(pos, end, value);
+        if (ec != std::errc()) {
+            return false;
+        }
+        pos = ptr;
+        return true;
+    }
+
+    [[noreturn]] inline void malformed(const char * line, const char * end)
+    {
+        throw std::runtime_error("malformed line: " + std::string(line, std::find(line, end, '\n')));
+    }
+
+    // line is the line the edge was read from, for the error message
+    template<typename weight_type, typename node_id_type>
+    void record_edge(ChunkResult<weight_type, node_id_type> & result, size_t from, size_t to, weight_type weight, const char * line, const char * end)
+    {
+        if (std::max(from, to) >= static_cast<size_t>(std::numeric_limits<node_id_type>::max())) {
+            throw std::out_of_range("node id too large for the node id type: " + std::string(line, std::find(line, end, '\n')));
+        }
+        result.edges.emplace_back(static_cast<node_id_type>(from), static_cast<node_id_type>(to), weight);
+        result.max_node = std::max({result.max_node, from, to});
+        result.any_node = true;
+    }
+
+    // the node of an "n id s" or "n id t" line. Like the ends of an arc it has to fit node_id_type.
+    template<typename node_id_type>
+    node_id_type read_terminal(size_t id, const char * line, const char * end)
+    {
+        if (id == 0 || id - 1 >= static_cast<size_t>(std::numeric_limits<node_id_type>::max())) {
+            malformed(line, end);
+        }
+        return static_cast<node_id_type>(id - 1);
+    }
+
+    // lines starting with one of these characters are skipped, for METIS they do not count as a node either
+    inline bool is_comment(char c, GraphFormat format)
+    {
+        switch (format) {
+            case GraphFormat::dimacs:
+            case GraphFormat::dimacs_flow:
+                return c == 'c';
+            case GraphFormat::snap:
+                return c == '#' || c == '%';
+            case GraphFormat::metis:
+                return c == '%';
+        }
+        return false;
+    }
+
+    // the number of lines in [begin, end) that describe a node, counted exactly as parse_chunk numbers them: every line
+    // but comments, empty lines included
+    inline size_t count_metis_lines(const char * begin, const char * end)
+    {
+        size_t count = 0;
+        for (const char * line = begin; line < end;) {
+            const char * line_end = std::find(line, end, '\n');
+            const char * pos = skip_blanks(line, line_end);
+            if (pos == line_end || !is_comment(*pos, GraphFormat::metis)) {
+                ++count;
+            }
+            line = line_end + 1;
+        }
+        return count;
+    }
+
+    // parses whole lines in [begin, end). first_node is the METIS node described by the first line.
+    template<typename weight_type, typename node_id_type>
+    void parse_chunk(const char * begin, const char * end, GraphFormat format, MetisLayout const & metis, size_t first_node, ChunkResult<weight_type, node_id_type> & result)
+    {
+        size_t metis_node = first_node;
+        for (const char * line = begin; line < end;) {
+            const char * line_end = std::find(line, end, '\n');
+            const char * pos = skip_blanks(line, line_end);
+            if (pos < line_end && is_comment(*pos, format)) {
+                line = line_end + 1;
+                continue;
+            }
+            switch (format) {
+                case GraphFormat::dimacs:
+                case GraphFormat::dimacs_flow: {
+                    if (pos == line_end) {
+                        break;
+                    }
+                    const char kind = *pos++;
+                    if (kind == 'p') {
+                        pos = skip_blanks(pos, line_end);
+                        while (pos < line_end && *pos != ' ' && *pos != '\t') {
+                            ++pos;
+                        }
+                        size_t n = 0;
+                        size_t m = 0;
+                        if (!read_number(pos, line_end, n) || !read_number(pos, line_end, m)) {
+                            malformed(line, end);
+                        }
+                        result.declared_nodes = n;
+                    }
+                    else if (kind == 'a') {
+                        size_t u = 0;
+                        size_t v = 0;
+                        weight_type w{};
+                        if (!read_number(pos, line_end, u) || !read_number(pos, line_end, v) || !read_number(pos, line_end, w) || u == 0 || v == 0) {
+                            malformed(line, end);
+                        }
+                        record_edge(result, u - 1, v - 1, w, line, end);
+                    }
+                    else if (kind == 'n' && format == GraphFormat::dimacs_flow) {
+                        size_t id = 0;
+                        if (!read_number(pos, line_end, id)) {
+                            malformed(line, end);
+                        }
+                        const node_id_type node = read_terminal<node_id_type>(id, line, end);
+                        pos = skip_blanks(pos, line_end);
+                        if (pos < line_end && *pos == 's') {
+                            result.source = node;
+                            result.source_line = line;
+                        }
+                        else if (pos < line_end && *pos == 't') {
+                            result.sink = node;
+                            result.sink_line = line;
+                        }
+                        else {
+                            malformed(line, end);
+                        }
+                    }
+                    else {
+                        malformed(line, end);
+                    }
+                    break;
+                }
+                case GraphFormat::snap: {
+                    if (pos == line_end) {
+                        break;
+                    }
+                    size_t u = 0;
+                    size_t v = 0;
+                    if (!read_number(pos, line_end, u) || !read_number(pos, line_end, v)) {
+                        malformed(line, end);
+                    }
+                    weight_type w = 1;
+                    pos = skip_blanks(pos, line_end);
+                    if (pos < line_end && !read_number(pos, line_end, w)) {
+                        malformed(line, end);
+                    }
+                    record_edge(result, u, v, w, line, end);
+                    break;
+                }
+                case GraphFormat::metis: {
+                    // surplus lines at the end of the file, typically empty, carry no node
+                    if (metis_node >= metis.num_nodes) {
+                        break;
+                    }
+                    size_t skipped = 0;
+                    for (int i = 0; i < metis.skipped_values; i++) {
+                        if (!read_number(pos, line_end, skipped)) {
+                            malformed(line, end);
+                        }
+                    }
+                    size_t neighbour = 0;
+                    while (read_number(pos, line_end, neighbour)) {
+                        weight_type w = 1;
+                        if ((metis.edge_weights && !read_number(pos, line_end, w)) || neighbour == 0) {
+                            malformed(line, end);
+                        }
+                        record_edge(result, metis_node, neighbour - 1, w, line, end);
+                    }
+                    if (skip_blanks(pos, line_end) != line_end) {
+                        malformed(line, end);
+                    }
+                    ++metis_node;
+                    break;
+                }
+            }
+            line = line_end + 1;
+        }
+    }
+
+    // moves pos past the comment lines at the start of [pos, end)
+    inline void skip_metis_comments(const char * & pos, const char * end)
+    {
+        while (pos < end) {
+            const char * line_end = std::find(pos, end, '\n');
+            const char * first = skip_blanks(pos, line_end);
+            if (first == line_end || !is_comment(*first, GraphFormat::metis)) {
+                return;
+            }
+            pos = line_end == end ? end : line_end + 1;
+        }
+    }
+
+    inline MetisLayout read_metis_header(const char * & pos, const char * end)
+    {
+        // the header is the first line that is not a comment
+        skip_metis_comments(pos, end);
+        if (pos == end) {
+            throw std::runtime_error("missing METIS header");
+        }
+        const char * line = pos;
+        const char * line_end = std::find(pos, end, '\n');
+        MetisLayout layout;
+        size_t m = 0;
+        if (!read_number(pos, line_end, layout.num_nodes) || !read_number(pos, line_end, m)) {
+            malformed(line, end);
+        }
+        std::string_view fmt;
+        pos = skip_blanks(pos, line_end);
+        const char * fmt_begin = pos;
+        while (pos < line_end && *pos != ' ' && *pos != '\t' && *pos != '\r') {
+            ++pos;
+        }
+        fmt = std::string_view(fmt_begin, pos - fmt_begin);
+        int ncon = 1;
+        pos = skip_blanks(pos, line_end);
+        if (pos < line_end && !read_number(pos, line_end, ncon)) {
+            malformed(line, end);
+        }
+        // fmt has up to three digits: vertex sizes, vertex weights, edge weights
+        const std::string digits = std::string(3 - std::min<size_t>(fmt.size(), 3), '0') + std::string(fmt);
+        layout.skipped_values = (digits[0] == '1' ? 1 : 0) + (digits[1] == '1' ? ncon : 0);
+        layout.edge_weights = digits[2] == '1';
+        pos = line_end == end ? end : line_end + 1;
+        return layout;
+    }
+
+    // splits [begin, end) into at most num_chunks pieces that each end just after a newline (or at end)
+    inline std::vector<const char *> split_at_lines(const char * begin, const char * end, unsigned num_chunks)
+    {
+        std::vector<const char *> bounds{begin};
+        const size_t size = end - begin;
+        for (unsigned t = 1; t < num_chunks; t++) {
+            const char * guess = begin + size * t / num_chunks;
+            if (guess < bounds.back()) {
+                continue;
+            }
+            const char * newline = std::find(guess, end, '\n');
+            if (newline >= end) {
+                break;
+            }
+            bounds.push_back(newline + 1);
+        }
+        bounds.push_back(end);
+        return bounds;
+    }
+
+    // parses the whole lines in [begin, end) on num_threads threads and appends the results to file in input order
+    template<typename weight_type, typename node_id_type>
+    void parse_parallel(const char * begin, const char * end, GraphFormat format, MetisLayout const & metis, size_t & metis_node,
+        unsigned num_threads, EdgeListFile<weight_type, node_id_type> & file)
+    {
+        const std::vector<const char *> bounds = split_at_lines(begin, end, num_threads);
+        const size_t num_chunks = bounds.size() - 1;
+        std::vector<ChunkResult<weight_type, node_id_type>> results(num_chunks);
+
+        // METIS lines are numbered, so every chunk has to know how many node lines precede it
+        std::vector<size_t> first_node(num_chunks, metis_node);
+        if (format == GraphFormat::metis) {
+            std::vector<size_t> counts(num_chunks);
+            std::vector<std::thread> counters;
+            for (size_t c = 0; c < num_chunks; c++) {
+                counters.emplace_back([&, c] { counts[c] = count_metis_lines(bounds[c], bounds[c + 1]); });
+            }
+            for (auto & thread : counters) {
+                thread.join();
+            }
+            for (size_t c = 1; c < num_chunks; c++) {
+                first_node[c] = first_node[c - 1] + counts[c - 1];
+            }
+            metis_node = first_node.back() + counts.back();
+        }
+
+        std::vector<std::thread> workers;
+        for (size_t c = 0; c < num_chunks; c++) {
+            workers.emplace_back([&, c] {
+                try {
+                    parse_chunk(bounds[c], bounds[c + 1], format, metis, first_node[c], results[c]);
+                }
+                catch (...) {
+                    results[c].error = std::current_exception();
+                }
+            });
+        }
+        for (auto & thread : workers) {
+            thread.join();
+        }
+
+        size_t total = file.edges.size();
+        for (auto const & result : results) {
+            if (result.error) {
+                std::rethrow_exception(result.error);
+            }
+            total += result.edges.size();
+        }
+        file.edges.reserve(total);
+        for (auto & result : results) {
+            file.edges.insert(file.edges.end(), result.edges.begin(), result.edges.end());
+            file.num_nodes = std::max(file.num_nodes, result.declared_nodes);
+            if (result.any_node) {
+                file.num_nodes = std::max(file.num_nodes, result.max_node + 1);
+            }
+            // the "p max n m" line and the arcs read so far give the nodes, and source and sink have to be among them
+            if (result.source) {
+                if (static_cast<size_t>(*result.source) >= file.num_nodes) {
+                    malformed(result.source_line, end);
+                }
+                file.source = result.source;
+            }
+            if (result.sink) {
+                if (static_cast<size_t>(*result.sink) >= file.num_nodes) {
+                    malformed(result.sink_line, end);
+                }
+                file.sink = result.sink;
+            }
+        }
+    }
+
+    inline unsigned default_threads(unsigned num_threads)
+    {
+        return num_threads != 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+// reads a graph from a stream in blocks of block_size bytes, so that the whole text never has to be held in memory
+template<typename weight_type, typename node_id_type = int>
+EdgeListFile<weight_type, node_id_type> read_edge_list(std::istream & in, GraphFormat format, unsigned num_threads = 0, size_t block_size = size_t(64) << 20)
+{
+    using namespace edge_list_detail;
+    num_threads = default_threads(num_threads);
+    EdgeListFile<weight_type, node_id_type> file;
+    MetisLayout metis;
+    size_t metis_node = 0;
+    bool header_read = format != GraphFormat::metis;
+
+    auto read_block = [&in, block_size] {
+        std::string block(block_size, '\0');
+        in.read(block.data(), static_cast<std::streamsize>(block_size));
+        block.resize(in.gcount());
+        return block;
+    };
+
+    // parses whole lines, the first of them is the METIS header if it has not been seen yet. The comments before the
+    // header may fill whole blocks.
+    auto consume = [&](const char * begin, const char * end) {
+        if (!header_read) {
+            skip_metis_comments(begin, end);
+            if (begin == end) {
+                return;
+            }
+            metis = read_metis_header(begin, end);
+            header_read = true;
+            file.num_nodes = metis.num_nodes;
+        }
+        if (begin < end) {
+            parse_parallel(begin, end, format, metis, metis_node, num_threads, file);
+        }
+    };
+
+    std::string pending = read_block();
+    const bool empty = pending.empty();
+    while (!pending.empty()) {
+        // read the next block while this one is being parsed
+        std::future<std::string> next = std::async(std::launch::async, read_block);
+        // only complete lines are parsed, the rest is carried over into the next block
+        const size_t last_newline = pending.rfind('\n');
+        const size_t cut = last_newline == std::string::npos ? 0 : last_newline + 1;
+        consume(pending.data(), pending.data() + cut);
+        std::string next_block = next.get();
+        if (next_block.empty()) {
+            // the input does not end with a newline
+            consume(pending.data() + cut, pending.data() + pending.size());
+            break;
+        }
+        pending = pending.substr(cut) + next_block;
+    }
+    if (!header_read && !empty) {
+        throw std::runtime_error("missing METIS header");
+    }
+    return file;
+}
+
+// reads a graph file, "-" stands for standard input
+template<typename weight_type, typename node_id_type = int>
+EdgeListFile<weight_type, node_id_type> read_edge_list(std::string const & path, GraphFormat format, unsigned num_threads = 0)
+{
+    using namespace edge_list_detail;
+    if (path == "-") {
+        return read_edge_list<weight_type, node_id_type>(std::cin, format, num_threads);
+    }
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("cannot read " + path);
+    }
+    const size_t size = info.st_size;
+    EdgeListFile<weight_type, node_id_type> file;
+    if (size == 0) {
+        close(fd);
+        return file;
+    }
+    void * address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("cannot map " + path);
+    }
+    madvise(address, size, MADV_SEQUENTIAL);
+    const char * begin = static_cast<const char *>(address);
+    const char * end = begin + size;
+    try {
+        MetisLayout metis;
+        size_t metis_node = 0;
+        if (format == GraphFormat::metis) {
+            metis = read_metis_header(begin, end);
+            file.num_nodes = metis.num_nodes;
+        }
+        if (begin < end) {
+            parse_parallel(begin, end, format, metis, metis_node, default_threads(num_threads), file);
+        }
+    }
+    catch (...) {
+        munmap(address, size);
+        throw;
+    }
+    munmap(address, size);
+    return file;
+}
+
+template<typename weight_type, typename node_id_type>
+Digraph<WeightedEdge<weight_type, node_id_type>> to_digraph(EdgeListFile<weight_type, node_id_type> const & file)
+{
+    Digraph<WeightedEdge<weight_type, node_id_type>> G(file.num_nodes);
+    for (auto const & edge : file.edges) {
+        G.add_edge(edge.from, edge.to, edge.weight);
+    }
+    return G;
+}
+
+// the weights are read as capacities, all flows start at zero
+template<typename weight_type, typename node_id_type>
+Digraph<NetworkEdge<weight_type, node_id_type>> to_network(EdgeListFile<weight_type, node_id_type> const & file)
+{
+    Digraph<NetworkEdge<weight_type, node_id_type>> G(file.num_nodes);
+    for (auto const & edge : file.edges) {
+        G.add_edge(edge.from, edge.to, edge.weight, 0);
+    }
+    return G;
+}
+
+template<typename weight_type, typename node_id_type>
+CSRDigraph<WeightedEdge<weight_type, node_id_type>> to_csr(EdgeListFile<weight_type, node_id_type> const & file)
+{
+    return CSRDigraph<WeightedEdge<weight_type, node_id_type>>(file.num_nodes, file.edges);
+}
+
+#endif //GRAPH_IO_EDGE_LIST_READER_H
@@ -0,0 +1,38 @@
+// Converts a graph given as text into the binary format of graph_io/binary_graph.h, so that later runs can map it.
+// usage: graph_convert [--int] <dimacs|dimacs-flow|snap|metis> <input file, or - for standard input> <output file>
+// with --int the weights are stored as integers, as needed by dijkstra_radix.
+// Author: Georgi Kocharyan
+
+#include <iostream>
+#include <string>
+
+#include "digraph.h"
+#include "graph_io/binary_graph.h"
+#include "graph_io/edge_list_reader.h"
+
+template<typename weight_type>
+void convert(GraphFormat format, std::string const & input, std::string const & output)
+{
+    const EdgeListFile<weight_type> file = read_edge_list<weight_type>(input, format);
+    const CSRDigraph<WeightedEdge<weight_type>> G = to_csr(file);
+    write_binary_graph(G, output, false);
+    std::cout << "Wrote " << G.num_nodes() << " nodes and " << G.num_edges() << " edges to " << output << "." << std::endl;
+}
+
+int main(int argc, char * argv[])
+{
+    const bool integral = argc > 1 && std::string(argv[1]) == "--int";
+    const int first = integral ? 2 : 1;
+    if (argc - first != 3) {
+        std::cerr << "usage: graph_convert [--int] <dimacs|dimacs-flow|snap|metis> <input|-> <output>" << std::endl;
+        return 1;
+    }
+    const GraphFormat format = parse_graph_format(argv[first]);
+    if (integral) {
+        convert<int>(format, argv[first + 1], argv[first + 2]);
+    }
+    else {
+        convert<double>(format, argv[first + 1], argv[first + 2]);
+    }
+    return 0;
+}
@@ -8,6 +8,7 @@
 #include <ostream>
 #include <queue>
 #include "digraph.h"
+#include "graph_io/edge_list_reader.h"
 
 using Network = Digraph<NetworkEdge<double>>;
 using Edge_n = NetworkEdge<double>;
@@ -57,9 +58,9 @@ double ford_fulkerson(Network & G, int source, int sink)
                 edge_reversed.reversed = true;
                 // partner up edge pairs
                 edge_reversed.partner = &edge;
-                edge.partner = &edge_reversed;
-                // add to edge list
+                // add to edge list, the partner of edge is the copy stored there
                 G.add_edge(edge_reversed);
+                edge.partner = &G.adjList_ref(edge.to).back();
             }
         }
     }
@@ -106,8 +107,33 @@ double ford_fulkerson(Network & G, int source, int sink)
 return max_flow;
 }
 
-int main()
+void print_flow(const Network & G, const double max_flow)
 {
+    std::cout << "The maximum flow is " << max_flow << "." << std::endl;
+    for (int node_id = 0; node_id < G.num_nodes(); ++node_id) {
+        for (const auto & edge: G.adjList(node_id)) {
+            if (!edge.reversed) {
+                std::cout << "The edge from " << edge.from << " to " << edge.to << " has capacity " << edge.capacity << " and flow " << edge.flow << "." << std::endl;
+            }
+        }
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    // a network in DIMACS max-flow format can be given as argument, "-" reads it from standard input
+    if (argc > 1) {
+        const EdgeListFile<double> file = read_edge_list<double>(argv[1], GraphFormat::dimacs_flow);
+        if (!file.source || !file.sink) {
+            std::cout << "The network has no source or no sink." << std::endl;
+            return 1;
+        }
+        Network G = to_network(file);
+        const double max_flow = ford_fulkerson(G, *file.source, *file.sink);
+        print_flow(G, max_flow);
+        return 0;
+    }
+
     constexpr int size = 5;
     Network G(size);
     G.add_edge(0,1,4,0);
@@ -118,13 +144,5 @@ int main()
 
     const double max_flow = ford_fulkerson(G,0,3);
 
-    std::cout << "The maximum flow is " << max_flow << "." << std::endl;
-    for (int node_id = 0; node_id < size; ++node_id) {
-        for (const auto & edge: G.adjList(node_id)) {
-            if (!edge.reversed) {
-                std::cout << "The edge from " << edge.from << " to " << edge.to << " has capacity " << edge.capacity << " and flow " << edge.flow << "." << std::endl;
-            }
-        }
-    }
+    print_flow(G, max_flow);
 }
-
@@ -0,0 +1,43 @@
+// Checks that the flows stored on the edges of a network form a flow of a given value, for the tests and benchmarks of
+// the maximum flow algorithms.
+// Author: Georgi Kocharyan
+
+#ifndef MAX_FLOWS_FLOW_CHECK_H
+#define MAX_FLOWS_FLOW_CHECK_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "digraph.h"
+
+// whether the flows on the edges respect the capacities and are conserved everywhere but at source and sink, where
+// value leaves and arrives. skip_reversed leaves out the reverse edges that a residual graph adds to G, and the balance
+// of a node may be off by tolerance * max(1, value), for flows that are computed with rounding.
+template<IsDigraph network_type>
+bool is_flow(network_type const & G, size_t source, size_t sink, double value, bool skip_reversed = false, double tolerance = 0)
+{
+    std::vector<double> balance(G.num_nodes(), 0);
+    for (size_t v = 0; v < G.num_nodes(); v++) {
+        for (const auto & edge : G.adjList(v)) {
+            if (skip_reversed && edge.reversed) {
+                continue;
+            }
+            if (edge.flow < 0 || edge.flow > edge.capacity) {
+                return false;
+            }
+            balance[edge.from] -= edge.flow;
+            balance[edge.to] += edge.flow;
+        }
+    }
+    for (size_t v = 0; v < G.num_nodes(); v++) {
+        const double expected = source == sink ? 0 : v == source ? -value : v == sink ? value : 0;
+        if (std::abs(balance[v] - expected) > tolerance * std::max(1.0, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif //MAX_FLOWS_FLOW_CHECK_H
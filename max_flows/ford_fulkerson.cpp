@@ -50,9 +50,9 @@ double ford_fulkerson(Network & G, int source, int sink)
                 edge_reversed.reversed = true;
                 // partner up edge pairs
                 edge_reversed.partner = &edge;
-                edge.partner = &edge_reversed;
-                // add to edge list
+                // add to edge list, the partner of edge is the copy stored there
                 G.add_edge(edge_reversed);
+                edge.partner = &G.adjList_ref(edge.to).back();
             }
         }
     }
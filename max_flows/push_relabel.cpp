@@ -0,0 +1,51 @@
+// Maximum flows with the highest label push-relabel algorithm of push_relabel.h, which unlike the augmenting path
+// methods of ford_fulkerson.cpp and edmonds_karp.cpp never searches the whole graph for a single path.
+// Author: Georgi Kocharyan
+
+#include <iostream>
+#include <ostream>
+#include "digraph.h"
+#include "graph_io/edge_list_reader.h"
+#include "max_flows/push_relabel.h"
+
+using Network = Digraph<NetworkEdge<double>>;
+
+void print_flow(const Network & G, const double max_flow)
+{
+    std::cout << "The maximum flow is " << max_flow << "." << std::endl;
+    for (int node_id = 0; node_id < G.num_nodes(); ++node_id) {
+        for (const auto & edge: G.adjList(node_id)) {
+            if (!edge.reversed) {
+                std::cout << "The edge from " << edge.from << " to " << edge.to << " has capacity " << edge.capacity << " and flow " << edge.flow << "." << std::endl;
+            }
+        }
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    // a network in DIMACS max-flow format can be given as argument, "-" reads it from standard input
+    if (argc > 1) {
+        const EdgeListFile<double> file = read_edge_list<double>(argv[1], GraphFormat::dimacs_flow);
+        if (!file.source || !file.sink) {
+            std::cout << "The network has no source or no sink." << std::endl;
+            return 1;
+        }
+        Network G = to_network(file);
+        const double max_flow = push_relabel(G, *file.source, *file.sink);
+        print_flow(G, max_flow);
+        return 0;
+    }
+
+    constexpr int size = 5;
+    Network G(size);
+    G.add_edge(0,1,4,0);
+    G.add_edge(0,2,5,0);
+    G.add_edge(1,3,2,0);
+    G.add_edge(1,4,1,0);
+    G.add_edge(2,3,3,0);
+
+    const double max_flow = push_relabel(G,0,3);
+
+    print_flow(G, max_flow);
+}
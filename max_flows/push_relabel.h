@@ -0,0 +1,314 @@
+// The highest label push-relabel algorithm of Goldberg and Tarjan for maximum flows, with the heuristics that make it
+// fast in practice: current arcs, so that a node resumes scanning its arcs where it stopped, the gap heuristic, which
+// lifts every node above a label that no node has anymore out of the search at once, and global relabelling, which now
+// and then sets all labels to the exact distances to the sink by a backward breadth first search. The first phase
+// computes a maximum preflow, whose excess reaching the sink is the value of a maximum flow, the second one returns the
+// excess stuck at other nodes to the source. O(n^2 sqrt(m)) time.
+// Author: Georgi Kocharyan
+
+#ifndef MAX_FLOWS_PUSH_RELABEL_H
+#define MAX_FLOWS_PUSH_RELABEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "digraph.h"
+
+namespace push_relabel_detail
+{
+    // The residual graph, with the arcs of every node next to each other. Every edge gives a forward arc with its
+    // capacity as residual capacity and a backward arc with none, and each arc knows the position of the other.
+    template<typename capacity_type, typename node_id_type, typename arc_index_type>
+    class Solver
+    {
+    public:
+        Solver(size_t num_nodes, std::vector<node_id_type> const & tails, std::vector<node_id_type> const & heads,
+            std::vector<capacity_type> const & capacities)
+            : n(num_nodes), first(num_nodes + 1, 0), head(2 * heads.size()), residual(2 * heads.size(), 0), reverse(2 * heads.size()),
+              forward(heads.size()), excess(num_nodes, 0), label(num_nodes), current(num_nodes), active_first(num_nodes, none),
+              active_next(num_nodes), all_first(num_nodes, none), all_next(num_nodes), all_previous(num_nodes)
+        {
+            for (size_t e = 0; e < heads.size(); e++) {
+                first[tails[e] + 1]++;
+                first[heads[e] + 1]++;
+            }
+            for (size_t v = 0; v < n; v++) {
+                first[v + 1] += first[v];
+            }
+            std::vector<arc_index_type> next(first.begin(), first.end() - 1);
+            for (size_t e = 0; e < heads.size(); e++) {
+                const arc_index_type out = next[tails[e]]++;
+                const arc_index_type back = next[heads[e]]++;
+                head[out] = heads[e];
+                head[back] = tails[e];
+                residual[out] = capacities[e];
+                reverse[out] = back;
+                reverse[back] = out;
+                forward[e] = out;
+            }
+        }
+
+        // the value of a maximum flow from source to sink, source != sink
+        capacity_type run(node_id_type source, node_id_type sink)
+        {
+            for (arc_index_type a = first[source]; a < first[source + 1]; a++) {
+                if (residual[a] > 0) {
+                    excess[head[a]] += residual[a];
+                    residual[reverse[a]] += residual[a];
+                    residual[a] = 0;
+                }
+            }
+            discharge_all(sink, source);
+            const capacity_type value = excess[sink];
+            // the excess left is returned to the source, which with the sink out of the way is the same problem
+            discharge_all(source, sink);
+            return value;
+        }
+
+        // the flow on edge e, which its backward arc can send back
+        capacity_type flow(size_t e) const
+        {
+            return residual[reverse[forward[e]]];
+        }
+
+    private:
+        static constexpr node_id_type none = std::numeric_limits<node_id_type>::max();
+
+        // pushes the excess of all nodes that can reach target to target, excluded takes no part. Labels are at most
+        // n - 1 for the nodes that can still reach target, n marks the others.
+        void discharge_all(node_id_type target, node_id_type excluded)
+        {
+            this->target = target;
+            this->excluded = excluded;
+            // global relabelling pays off once the relabels since the last one scanned about as many arcs as it does
+            const size_t relabel_limit = 12 * n + 2 * head.size();
+            global_relabel();
+            while (max_active >= 0) {
+                const node_id_type v = active_first[max_active];
+                if (v == none) {
+                    max_active--;
+                    continue;
+                }
+                active_first[max_active] = active_next[v];
+                discharge(v);
+                if (work > relabel_limit) {
+                    global_relabel();
+                }
+            }
+        }
+
+        // sets the labels to the distances to target in the residual graph and rebuilds the lists of the labels
+        void global_relabel()
+        {
+            work = 0;
+            std::fill(label.begin(), label.end(), static_cast<node_id_type>(n));
+            std::fill(active_first.begin(), active_first.end(), none);
+            std::fill(all_first.begin(), all_first.end(), none);
+            max_active = -1;
+            max_label = 0;
+            std::vector<node_id_type> queue{target};
+            label[target] = 0;
+            for (size_t i = 0; i < queue.size(); i++) {
+                const node_id_type v = queue[i];
+                for (arc_index_type a = first[v]; a < first[v + 1]; a++) {
+                    const node_id_type u = head[a];
+                    // u can send to v over the arc paired with a
+                    if (label[u] == n && u != excluded && residual[reverse[a]] > 0) {
+                        label[u] = label[v] + 1;
+                        queue.push_back(u);
+                    }
+                }
+            }
+            for (size_t i = 1; i < queue.size(); i++) {
+                const node_id_type v = queue[i];
+                current[v] = first[v];
+                insert(v);
+                if (excess[v] > 0) {
+                    activate(v);
+                }
+            }
+        }
+
+        void insert(node_id_type v)
+        {
+            const node_id_type d = label[v];
+            all_previous[v] = none;
+            all_next[v] = all_first[d];
+            if (all_first[d] != none) {
+                all_previous[all_first[d]] = v;
+            }
+            all_first[d] = v;
+            max_label = std::max<ptrdiff_t>(max_label, d);
+        }
+
+        void remove(node_id_type v)
+        {
+            if (all_previous[v] != none) {
+                all_next[all_previous[v]] = all_next[v];
+            }
+            else {
+                all_first[label[v]] = all_next[v];
+            }
+            if (all_next[v] != none) {
+                all_previous[all_next[v]] = all_previous[v];
+            }
+        }
+
+        void activate(node_id_type v)
+        {
+            active_next[v] = active_first[label[v]];
+            active_first[label[v]] = v;
+            max_active = std::max<ptrdiff_t>(max_active, label[v]);
+        }
+
+        // pushes the excess of v over admissible arcs, those with residual capacity to a node one label lower, and
+        // relabels v whenever it has none left, until v has no excess or cannot reach target anymore
+        void discharge(node_id_type v)
+        {
+            while (true) {
+                const node_id_type d = label[v];
+                arc_index_type a = current[v];
+                for (; a < first[v + 1]; a++) {
+                    const node_id_type u = head[a];
+                    if (residual[a] > 0 && label[u] + 1 == d) {
+                        const capacity_type delta = std::min(excess[v], residual[a]);
+                        residual[a] -= delta;
+                        residual[reverse[a]] += delta;
+                        excess[v] -= delta;
+                        if (excess[u] == 0 && u != target) {
+                            activate(u);
+                        }
+                        excess[u] += delta;
+                        if (excess[v] == 0) {
+                            break;
+                        }
+                    }
+                }
+                if (excess[v] == 0) {
+                    current[v] = a;
+                    return;
+                }
+                remove(v);
+                if (all_first[d] == none) {
+                    // no node has label d anymore, so no node above it can reach target
+                    gap(d);
+                    label[v] = static_cast<node_id_type>(n);
+                    return;
+                }
+                relabel(v);
+                if (label[v] == n) {
+                    return;
+                }
+                insert(v);
+            }
+        }
+
+        // the smallest label that makes an arc out of v admissible
+        void relabel(node_id_type v)
+        {
+            node_id_type lowest = static_cast<node_id_type>(n);
+            arc_index_type lowest_arc = first[v];
+            for (arc_index_type a = first[v]; a < first[v + 1]; a++) {
+                if (residual[a] > 0 && label[head[a]] + 1 < lowest) {
+                    lowest = label[head[a]] + 1;
+                    lowest_arc = a;
+                }
+            }
+            work += 12 + (first[v + 1] - first[v]);
+            label[v] = lowest;
+            current[v] = lowest_arc;
+        }
+
+        // takes every node with a label above d out of the search
+        void gap(node_id_type d)
+        {
+            for (ptrdiff_t above = d + 1; above <= max_label; above++) {
+                for (node_id_type v = all_first[above]; v != none; v = all_next[v]) {
+                    label[v] = static_cast<node_id_type>(n);
+                }
+                all_first[above] = none;
+                active_first[above] = none;
+            }
+            max_label = d - 1;
+            max_active = std::min<ptrdiff_t>(max_active, d - 1);
+        }
+
+        const size_t n;
+        std::vector<arc_index_type> first;
+        std::vector<node_id_type> head;
+        std::vector<capacity_type> residual;
+        std::vector<arc_index_type> reverse;
+        // the forward arc of every edge
+        std::vector<arc_index_type> forward;
+        std::vector<capacity_type> excess;
+        std::vector<node_id_type> label;
+        std::vector<arc_index_type> current;
+        // the active nodes of every label in a stack, and all nodes of every label in a doubly linked list
+        std::vector<node_id_type> active_first;
+        std::vector<node_id_type> active_next;
+        std::vector<node_id_type> all_first;
+        std::vector<node_id_type> all_next;
+        std::vector<node_id_type> all_previous;
+        ptrdiff_t max_active = -1;
+        ptrdiff_t max_label = 0;
+        size_t work = 0;
+        node_id_type target = 0;
+        node_id_type excluded = 0;
+    };
+}
+
+// The value of a maximum flow from source to sink, whose flow on every edge is stored in its flow member. Edges marked
+// as reversed, as ford_fulkerson adds them for its residual graph, only take over the flow of their partners. A maximum
+// flow is not unique in general, so the flows on the edges may differ from those of ford_fulkerson, but their value
+// does not.
+template<typename edge_type, typename edge_count_t>
+    requires HasFlow<edge_type>
+typename edge_type::weight_type push_relabel(Digraph<edge_type, edge_count_t> & G, typename edge_type::node_id_type source,
+    typename edge_type::node_id_type sink)
+{
+    using capacity_type = typename edge_type::weight_type;
+    using node_id_type = typename edge_type::node_id_type;
+    using arc_index_type = std::conditional_t<sizeof(edge_count_t) <= 4, uint32_t, uint64_t>;
+    std::vector<node_id_type> tails;
+    std::vector<node_id_type> heads;
+    std::vector<capacity_type> capacities;
+    tails.reserve(G.num_edges());
+    heads.reserve(G.num_edges());
+    capacities.reserve(G.num_edges());
+    for (node_id_type v = 0; v < G.num_nodes(); v++) {
+        for (const auto & edge : G.adjList(v)) {
+            // loops carry no flow from source to sink
+            if (!edge.reversed && edge.from != edge.to) {
+                tails.push_back(edge.from);
+                heads.push_back(edge.to);
+                capacities.push_back(edge.capacity);
+            }
+        }
+    }
+    push_relabel_detail::Solver<capacity_type, node_id_type, arc_index_type> solver(G.num_nodes(), tails, heads, capacities);
+    const capacity_type value = source == sink ? 0 : solver.run(source, sink);
+
+    // the edges are visited in the same order as above
+    size_t e = 0;
+    for (node_id_type v = 0; v < G.num_nodes(); v++) {
+        for (auto & edge : G.adjList_ref(v)) {
+            if (!edge.reversed) {
+                edge.flow = edge.from != edge.to ? solver.flow(e++) : 0;
+            }
+        }
+    }
+    for (node_id_type v = 0; v < G.num_nodes(); v++) {
+        for (auto & edge : G.adjList_ref(v)) {
+            if (edge.reversed) {
+                edge.flow = edge.partner->flow;
+            }
+        }
+    }
+    return value;
+}
+
+#endif //MAX_FLOWS_PUSH_RELABEL_H
@@ -26,7 +26,7 @@ void kruskal(WeightedGraph const &G)
     WeightedGraph H(G.num_nodes());
 
     for (int i = 0; i < G.num_nodes(); i++) {
-        for (const auto edge: G.adjList(i)) {
+        for (const auto & edge: G.adjList(i)) {
             H.add_edge(edge.to,edge.from, edge.weight);
             H.add_edge(edge.from,edge.to, edge.weight);
         }
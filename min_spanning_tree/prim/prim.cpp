@@ -64,7 +64,7 @@ void prim(WeightedGraph const & G) {
     WeightedGraph H(G.num_nodes());
 
     for (int i = 0; i < G.num_nodes(); i++) {
-        for (const auto edge: G.adjList(i)) {
+        for (const auto & edge: G.adjList(i)) {
             H.add_edge(edge.to,edge.from, edge.weight);
             H.add_edge(edge.from,edge.to, edge.weight);
         }
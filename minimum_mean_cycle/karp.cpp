@@ -8,29 +8,29 @@
 
 #include <digraph.h>
 #include <minimum_mean_cycle/kosaraju.h>
+#include <shortest_paths/edge_arrays.h>
 
 
 using WeightedDigraph = Digraph<WeightedEdge<double>>;
 
-double karp(const WeightedDigraph & G, int starting_node)
+template<IsDigraph graph_type>
+double karp(const graph_type & G, typename graph_type::node_id_type starting_node)
 {
+    using node_id_type = typename graph_type::node_id_type;
     std::vector<std::vector<double>> F(G.num_nodes()+1, std::vector<double>(G.num_nodes(), std::numeric_limits<double>::max()));
 
     // compute the values of F recursively. F[k][i] is interpreted as the length of the shortest path from starting_node to i containing exactly k edges.
     F[0][starting_node] = 0;
-    for (int k = 1; k <= G.num_nodes(); ++k) {
-        for (int node_id = 0; node_id < G.num_nodes(); ++node_id) {
-            for (const auto & edge : G.adjList(node_id)) {
-                F[k][edge.to] = std::min(F[k][edge.to], F[k-1][edge.from] + edge.weight);
-            }
-        }
+    const EdgeArrays<double, node_id_type> edges(G);
+    for (size_t k = 1; k <= G.num_nodes(); ++k) {
+        relax_all_edges(edges, F[k-1].data(), F[k].data());
     }
 
     // compute min_{ x \in V(G) } max_{0 \leq k \leq n-1} (F[n][x] - F[k][x])/(n-k)
     std::vector<double> mins(G.num_nodes());
-    for (int node_id = 0; node_id < G.num_nodes(); node_id++) {
+    for (node_id_type node_id = 0; node_id < G.num_nodes(); node_id++) {
         std::vector<double> maxs(G.num_nodes());
-        for (int k = 0; k < G.num_nodes(); ++k) {
+        for (size_t k = 0; k < G.num_nodes(); ++k) {
             maxs[k] = (F[G.num_nodes()][node_id] - F[k][node_id])/(G.num_nodes() - k);
         }
         mins[node_id]  = *max_element(maxs.begin(), maxs.end());
@@ -11,7 +11,8 @@
 
 using UnweightedDigraph = Digraph<Edge>;
 // push nodes in post-order
-void dfs1(UnweightedDigraph const & G, int n, std::vector<bool> & vis, std::stack<int> & node_order) {
+template<IsDigraph graph_type>
+void dfs1(graph_type const & G, typename graph_type::node_id_type n, std::vector<bool> & vis, std::stack<typename graph_type::node_id_type> & node_order) {
     if (vis[n])
     {
       return;  //if node is already visited don't
@@ -19,7 +20,7 @@ void dfs1(UnweightedDigraph const & G, int n, std::vector<bool> & vis, std::stac
 
     vis[n] = true;
 
-    for(auto i: G.adjList(n))
+    for(const auto & i: G.adjList(n))
     {
         dfs1(G, i.to, vis, node_order);
     }
@@ -27,8 +28,9 @@ void dfs1(UnweightedDigraph const & G, int n, std::vector<bool> & vis, std::stac
     node_order.push(n);
 }
 
-//this function traverses the transpose graph
-void dfs2(UnweightedDigraph const & G, int n, std::vector<bool> & vis2, std::stack<int> & node_order){
+//this function traverses the transpose graph, by following the edges into each node backwards
+template<HasInEdges graph_type>
+void dfs2(graph_type const & G, typename graph_type::node_id_type n, std::vector<bool> & vis2, std::stack<typename graph_type::node_id_type> & node_order){
     if (vis2[n])
     {
       return;  // if node is already visited
@@ -37,28 +39,29 @@ void dfs2(UnweightedDigraph const & G, int n, std::vector<bool> & vis2, std::sta
     std::cout << n << " ";
     vis2[n] = true;
 
-    for(auto i: G.adjList(n))
+    for(const auto & i: G.inAdjList(n))
     {
-        dfs2(G, i.to, vis2, node_order);
+        dfs2(G, i.from, vis2, node_order);
     }
 }
 
 // print each component in seperate line, output amount
-int kosaraju(UnweightedDigraph const & G) {
+template<HasInEdges graph_type>
+int kosaraju(graph_type const & G) {
     int scc_count = 0;   //keep count of strongly connected components
-    std::stack<int> node_order;
+    std::stack<typename graph_type::node_id_type> node_order;
     std::vector<bool> vis2 (G.num_nodes(), false);  
     std::vector<bool> vis (G.num_nodes(), false);                       //store node visit stat for dfs
-    for(int i = 0; i < G.num_nodes(); i++)
+    for(typename graph_type::node_id_type i = 0; i < G.num_nodes(); i++)
     {
             dfs1(G, i, vis, node_order);
     }
     while(!node_order.empty()) {
-        int node_id = node_order.top();
+        const auto node_id = node_order.top();
         node_order.pop();
         if (vis2[node_id] == false)
         {
-            dfs2(G.transpose(), node_id, vis2, node_order);
+            dfs2(G, node_id, vis2, node_order);
             scc_count++;
             std::cout << std::endl;
         }
@@ -0,0 +1,470 @@
+// Relabels the nodes of a graph so that nodes which are used together get nearby ids.
+// The algorithms index arrays such as min_distances by node id, and with arbitrary ids almost every such access on a large
+// sparse graph misses the cache. The relabelled graph names every node after its old id, as contract_set does,
+// so that results computed on it can be translated back.
+// Author: Georgi Kocharyan
+
+#ifndef REORDERING_NODE_ORDER_H
+#define REORDERING_NODE_ORDER_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "digraph.h"
+
+enum class NodeOrder
+{
+    original, // the identity
+    degree, // by decreasing total degree, so that the hubs share a few cache lines
+    bfs, // breadth first search along the out-edges
+    dfs, // depth first search preorder along the out-edges
+    rcm, // reverse Cuthill-McKee on the underlying undirected graph
+    gorder // greedy window ordering in the style of Gorder (Wei et al. 2016)
+};
+
+inline NodeOrder parse_node_order(std::string const & name)
+{
+    if (name == "original") {
+        return NodeOrder::original;
+    }
+    if (name == "degree") {
+        return NodeOrder::degree;
+    }
+    if (name == "bfs") {
+        return NodeOrder::bfs;
+    }
+    if (name == "dfs") {
+        return NodeOrder::dfs;
+    }
+    if (name == "rcm") {
+        return NodeOrder::rcm;
+    }
+    if (name == "gorder") {
+        return NodeOrder::gorder;
+    }
+    throw std::invalid_argument("unknown node order " + name + " (expected original, degree, bfs, dfs, rcm or gorder)");
+}
+
+namespace node_order_detail
+{
+    // neighbourhoods of all nodes as offset and neighbour arrays
+    template<typename node_id_type>
+    struct Adjacency
+    {
+        std::vector<size_t> offsets;
+        std::vector<node_id_type> neighbours;
+
+        size_t degree(size_t node_id) const
+        {
+            return offsets[node_id + 1] - offsets[node_id];
+        }
+
+        std::span<const node_id_type> operator[](size_t node_id) const
+        {
+            return std::span<const node_id_type>(neighbours).subspan(offsets[node_id], degree(node_id));
+        }
+    };
+
+    // with out set, v is a neighbour of u for every edge (u, v), with in set for every edge (v, u).
+    // both together give the underlying undirected graph.
+    template<IsDigraph graph_type>
+    Adjacency<typename graph_type::node_id_type> build_adjacency(graph_type const & G, bool out, bool in)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        Adjacency<node_id_type> A;
+        A.offsets.assign(G.num_nodes() + 1, 0);
+        for (node_id_type i = 0; i < G.num_nodes(); i++) {
+            for (auto const & edge : G.adjList(i)) {
+                A.offsets[edge.from + 1] += out;
+                A.offsets[edge.to + 1] += in;
+            }
+        }
+        std::partial_sum(A.offsets.begin(), A.offsets.end(), A.offsets.begin());
+        A.neighbours.resize(A.offsets.back());
+        std::vector<size_t> next(A.offsets.begin(), A.offsets.end() - 1);
+        for (node_id_type i = 0; i < G.num_nodes(); i++) {
+            for (auto const & edge : G.adjList(i)) {
+                if (out) {
+                    A.neighbours[next[edge.from]++] = edge.to;
+                }
+                if (in) {
+                    A.neighbours[next[edge.to]++] = edge.from;
+                }
+            }
+        }
+        return A;
+    }
+
+    template<IsDigraph graph_type>
+    std::vector<typename graph_type::node_id_type> degree_order(graph_type const & G)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        auto degrees = G.indegrees();
+        for (node_id_type i = 0; i < G.num_nodes(); i++) {
+            degrees[i] += G.outdeg(i);
+        }
+        std::vector<node_id_type> order(G.num_nodes());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](node_id_type a, node_id_type b) { return degrees[a] > degrees[b]; });
+        return order;
+    }
+
+    // every node not reached so far starts a new search, in the order of the old ids
+    template<IsDigraph graph_type>
+    std::vector<typename graph_type::node_id_type> bfs_order(graph_type const & G)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        std::vector<node_id_type> order;
+        order.reserve(G.num_nodes());
+        std::vector<bool> visited(G.num_nodes(), false);
+        for (node_id_type root = 0; root < G.num_nodes(); root++) {
+            if (visited[root]) {
+                continue;
+            }
+            visited[root] = true;
+            order.push_back(root);
+            // the order itself serves as the queue
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                for (auto const & edge : G.adjList(order[head])) {
+                    if (!visited[edge.to]) {
+                        visited[edge.to] = true;
+                        order.push_back(edge.to);
+                    }
+                }
+            }
+        }
+        return order;
+    }
+
+    template<IsDigraph graph_type>
+    std::vector<typename graph_type::node_id_type> dfs_order(graph_type const & G)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        using iterator = decltype(G.adjList(0).begin());
+        std::vector<node_id_type> order;
+        order.reserve(G.num_nodes());
+        std::vector<bool> visited(G.num_nodes(), false);
+        // iterative, so that long paths do not overflow the call stack. Every entry holds the out-edges still to be visited.
+        std::vector<std::pair<iterator, iterator>> stack;
+        auto visit = [&](node_id_type node_id) {
+            visited[node_id] = true;
+            order.push_back(node_id);
+            auto const & edges = G.adjList(node_id);
+            stack.emplace_back(edges.begin(), edges.end());
+        };
+        for (node_id_type root = 0; root < G.num_nodes(); root++) {
+            if (visited[root]) {
+                continue;
+            }
+            visit(root);
+            while (!stack.empty()) {
+                auto & [next, end] = stack.back();
+                if (next == end) {
+                    stack.pop_back();
+                    continue;
+                }
+                const node_id_type to = (*next).to;
+                ++next;
+                if (!visited[to]) {
+                    visit(to);
+                }
+            }
+        }
+        return order;
+    }
+
+    // Cuthill-McKee numbers the nodes breadth first from a node of minimum degree, visiting the neighbours of every node
+    // by increasing degree. Reversing the result keeps the bandwidth and tends to shrink the profile further.
+    template<IsDigraph graph_type>
+    std::vector<typename graph_type::node_id_type> rcm_order(graph_type const & G)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        const auto A = build_adjacency(G, true, true);
+        std::vector<node_id_type> by_degree(G.num_nodes());
+        std::iota(by_degree.begin(), by_degree.end(), 0);
+        auto smaller_degree = [&A](node_id_type a, node_id_type b) { return A.degree(a) < A.degree(b); };
+        std::stable_sort(by_degree.begin(), by_degree.end(), smaller_degree);
+
+        std::vector<node_id_type> order;
+        order.reserve(G.num_nodes());
+        std::vector<bool> visited(G.num_nodes(), false);
+        for (node_id_type root : by_degree) {
+            if (visited[root]) {
+                continue;
+            }
+            visited[root] = true;
+            order.push_back(root);
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                const size_t first = order.size();
+                for (node_id_type neighbour : A[order[head]]) {
+                    if (!visited[neighbour]) {
+                        visited[neighbour] = true;
+                        order.push_back(neighbour);
+                    }
+                }
+                std::stable_sort(order.begin() + first, order.end(), smaller_degree);
+            }
+        }
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    // nodes kept in one doubly linked list per key, where keys only ever change by one. This makes every operation
+    // constant time, which is what Gorder needs, as every placement changes the scores of many nodes.
+    template<typename node_id_type>
+    class UnitHeap
+    {
+    public:
+        explicit UnitHeap(size_t n) : key(n, 0), prev(n), next(n), heads(1, none)
+        {
+            for (size_t i = n; i-- > 0;) {
+                link(i);
+            }
+        }
+
+        bool contains(node_id_type node_id) const
+        {
+            return key[node_id] != removed;
+        }
+
+        void increment(node_id_type node_id)
+        {
+            unlink(node_id);
+            if (++key[node_id] == heads.size()) {
+                heads.push_back(none);
+            }
+            top = std::max(top, key[node_id]);
+            link(node_id);
+        }
+
+        void decrement(node_id_type node_id)
+        {
+            unlink(node_id);
+            --key[node_id];
+            link(node_id);
+        }
+
+        // removes and returns a node of maximum key, the heap must not be empty
+        node_id_type pop()
+        {
+            while (heads[top] == none) {
+                --top;
+            }
+            const node_id_type node_id = heads[top];
+            unlink(node_id);
+            key[node_id] = removed;
+            return node_id;
+        }
+
+        void remove(node_id_type node_id)
+        {
+            unlink(node_id);
+            key[node_id] = removed;
+        }
+
+    private:
+        static constexpr size_t none = std::numeric_limits<size_t>::max();
+        static constexpr size_t removed = std::numeric_limits<size_t>::max();
+        std::vector<size_t> key;
+        std::vector<size_t> prev;
+        std::vector<size_t> next;
+        std::vector<size_t> heads; // first node of every key
+        size_t top = 0; // no key above it is in use
+
+        void link(size_t node_id)
+        {
+            prev[node_id] = none;
+            next[node_id] = heads[key[node_id]];
+            if (next[node_id] != none) {
+                prev[next[node_id]] = node_id;
+            }
+            heads[key[node_id]] = node_id;
+        }
+
+        void unlink(size_t node_id)
+        {
+            if (prev[node_id] != none) {
+                next[prev[node_id]] = next[node_id];
+            }
+            else {
+                heads[key[node_id]] = next[node_id];
+            }
+            if (next[node_id] != none) {
+                prev[next[node_id]] = prev[node_id];
+            }
+        }
+    };
+
+    // Gorder places next the node that is most related to the last window nodes placed. Two nodes are related once for
+    // every edge between them and once for every node with an edge into both of them. The scores are kept up to date
+    // while nodes enter and leave the window.
+    template<IsDigraph graph_type>
+    std::vector<typename graph_type::node_id_type> gorder_order(graph_type const & G, size_t window)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        const size_t n = G.num_nodes();
+        std::vector<node_id_type> order;
+        if (n == 0) {
+            return order;
+        }
+        order.reserve(n);
+        const auto out = build_adjacency(G, true, false);
+        const auto in = build_adjacency(G, false, true);
+        // hubs relate too many pairs of nodes to be worth the time, and they are skipped as common in-neighbours
+        const size_t hub_limit = std::max<size_t>(16, static_cast<size_t>(std::sqrt(static_cast<double>(n))));
+
+        UnitHeap<node_id_type> scores(n);
+        auto update_related = [&](node_id_type node_id, bool entering) {
+            auto bump = [&](node_id_type related) {
+                if (scores.contains(related)) {
+                    entering ? scores.increment(related) : scores.decrement(related);
+                }
+            };
+            for (node_id_type successor : out[node_id]) {
+                bump(successor);
+            }
+            for (node_id_type predecessor : in[node_id]) {
+                bump(predecessor);
+                if (out.degree(predecessor) <= hub_limit) {
+                    for (node_id_type sibling : out[predecessor]) {
+                        if (sibling != node_id) {
+                            bump(sibling);
+                        }
+                    }
+                }
+            }
+        };
+
+        // start with the node of largest in-degree, as Gorder does
+        node_id_type current = 0;
+        for (node_id_type i = 1; i < n; i++) {
+            if (in.degree(i) > in.degree(current)) {
+                current = i;
+            }
+        }
+        scores.remove(current);
+        while (true) {
+            order.push_back(current);
+            update_related(current, true);
+            if (order.size() > window) {
+                update_related(order[order.size() - 1 - window], false);
+            }
+            if (order.size() == n) {
+                break;
+            }
+            current = scores.pop();
+        }
+        return order;
+    }
+}
+
+// order[i] is the old id of the node that gets the new id i. window is only used by NodeOrder::gorder.
+template<IsDigraph graph_type>
+std::vector<typename graph_type::node_id_type> compute_node_order(graph_type const & G, NodeOrder method, size_t window = 5)
+{
+    using namespace node_order_detail;
+    using node_id_type = typename graph_type::node_id_type;
+    switch (method) {
+        case NodeOrder::degree:
+            return degree_order(G);
+        case NodeOrder::bfs:
+            return bfs_order(G);
+        case NodeOrder::dfs:
+            return dfs_order(G);
+        case NodeOrder::rcm:
+            return rcm_order(G);
+        case NodeOrder::gorder:
+            return gorder_order(G, window);
+        default:
+            break;
+    }
+    std::vector<node_id_type> order(G.num_nodes());
+    std::iota(order.begin(), order.end(), 0);
+    return order;
+}
+
+// position[v] is the new id of the node with old id v
+template<typename node_id_type>
+std::vector<node_id_type> inverse_order(std::vector<node_id_type> const & order)
+{
+    std::vector<node_id_type> position(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        position[order[i]] = i;
+    }
+    return position;
+}
+
+// node i of the result is node order[i] of G and is named order[i]. The out-edges of every node keep their order.
+// Networks are not supported, since the partner pointers of their edges cannot be carried over.
+template<typename edge_type, typename edge_count_t> requires (!HasFlow<edge_type>)
+Digraph<edge_type, edge_count_t> relabel(Digraph<edge_type, edge_count_t> const & G, std::vector<typename edge_type::node_id_type> const & order)
+{
+    using node_id_type = typename edge_type::node_id_type;
+    const std::vector<node_id_type> position = inverse_order(order);
+    Digraph<edge_type, edge_count_t> H(G.num_nodes(), G.external_resource());
+    for (node_id_type i = 0; i < G.num_nodes(); i++) {
+        H.name_node(i, order[i]);
+        for (auto const & edge : G.adjList(order[i])) {
+            if constexpr (IsWeighted<edge_type>) {
+                H.add_edge(i, position[edge.to], edge.weight);
+            }
+            else {
+                edge_type relabelled = edge;
+                relabelled.from = i;
+                relabelled.to = position[edge.to];
+                H.add_edge(relabelled);
+            }
+        }
+    }
+    return H;
+}
+
+template<typename edge_type, typename edge_index_t>
+CSRDigraph<edge_type, edge_index_t> relabel(CSRDigraph<edge_type, edge_index_t> const & G, std::vector<typename edge_type::node_id_type> const & order)
+{
+    using node_id_type = typename edge_type::node_id_type;
+    const std::vector<node_id_type> position = inverse_order(order);
+    std::vector<edge_type> edges;
+    edges.reserve(G.num_edges());
+    for (node_id_type i = 0; i < G.num_nodes(); i++) {
+        for (edge_type edge : G.adjList(order[i])) {
+            edge.from = i;
+            edge.to = position[edge.to];
+            edges.push_back(edge);
+        }
+    }
+    return CSRDigraph<edge_type, edge_index_t>(G.num_nodes(), edges, order);
+}
+
+// values computed on a relabelled graph H, rearranged so that they are indexed by the old ids again
+template<IsDigraph graph_type, typename T>
+std::vector<T> to_original_order(graph_type const & H, std::vector<T> const & values)
+{
+    std::vector<T> result(values.size());
+    for (typename graph_type::node_id_type i = 0; i < H.num_nodes(); i++) {
+        result[H.node_name(i)] = values[i];
+    }
+    return result;
+}
+
+// the same for arrays of node ids such as predecessor, whose entries are translated back as well. Entries that are no
+// node of H, such as the maximum of node_id_type that marks unreachable nodes, are kept as they are.
+template<IsDigraph graph_type>
+std::vector<typename graph_type::node_id_type> to_original_ids(graph_type const & H, std::vector<typename graph_type::node_id_type> const & ids)
+{
+    std::vector<typename graph_type::node_id_type> result(ids.size());
+    for (typename graph_type::node_id_type i = 0; i < H.num_nodes(); i++) {
+        const auto id = ids[i];
+        result[H.node_name(i)] = static_cast<size_t>(id) < H.num_nodes() ? H.node_name(id) : id;
+    }
+    return result;
+}
+
+#endif //REORDERING_NODE_ORDER_H
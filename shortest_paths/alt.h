@@ -0,0 +1,506 @@
+// A* search with landmarks and the triangle inequality (ALT) for point-to-point queries in a directed weighted graph with
+// nonnegative weights. Preprocessing picks k landmarks and stores the distances from and to each of them. For a node v,
+// a target t and a landmark L, d(v, t) >= d(v, L) - d(t, L) and d(v, t) >= d(L, t) - d(L, v), so the largest of these
+// bounds is a feasible potential, and A* with it settles the nodes roughly in the direction of the target.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_ALT_H
+#define SHORTEST_PATHS_ALT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "digraph.h"
+#include "graph_io/binary_graph.h"
+#include "shortest_paths/bidirectional_dijkstra.h"
+#include "shortest_paths/d_ary_heap.h"
+#include "shortest_paths/dijkstra.h"
+
+enum class LandmarkSelection
+{
+    // each new landmark is the node farthest from the ones chosen so far
+    farthest,
+    // the leaf of the largest subtree of a random shortest path tree whose distances the chosen landmarks bound badly,
+    // following Goldberg and Werneck
+    avoid
+};
+
+// distances from and to every landmark, stored node by node, so that a potential reads k consecutive entries.
+// Unreachable pairs hold std::numeric_limits<double>::max().
+template<typename node_id_type = int>
+struct LandmarkTables
+{
+    std::vector<node_id_type> landmarks;
+    uint64_t num_nodes = 0;
+    // identifies the graph together with num_nodes, so that tables of another graph are not used by mistake
+    uint64_t num_edges = 0;
+    // from_landmark[v * k + i] = d(landmarks[i], v), to_landmark[v * k + i] = d(v, landmarks[i])
+    std::vector<double> from_landmark;
+    std::vector<double> to_landmark;
+
+    size_t size() const
+    {
+        return landmarks.size();
+    }
+};
+
+namespace alt_detail
+{
+    constexpr double unreachable = std::numeric_limits<double>::max();
+
+    // the distances from measuring_from, or to it if backward, following the in-edges
+    template<bool backward, HasInEdges graph_type>
+    std::vector<double> distances(const graph_type & G, typename graph_type::node_id_type measuring_from)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        std::vector<double> min_distances(G.num_nodes(), unreachable);
+        if constexpr (!backward) {
+            std::vector<node_id_type> predecessor(G.num_nodes(), measuring_from);
+            dijkstra(G, min_distances, measuring_from, predecessor);
+        }
+        else {
+            // dijkstra on the in-edges
+            min_distances[measuring_from] = 0;
+            IndexedDAryHeap<double, node_id_type> heap(G.num_nodes());
+            heap.push(measuring_from, 0);
+            while (!heap.empty()) {
+                const auto [node_id, distance] = heap.pop();
+                for (const auto & edge : G.inAdjList(node_id)) {
+                    const double candidate = distance + edge.weight;
+                    if (candidate < min_distances[edge.from]) {
+                        min_distances[edge.from] = candidate;
+                        heap.push_or_decrease(edge.from, candidate);
+                    }
+                }
+            }
+        }
+        return min_distances;
+    }
+
+    // runs task(i) for i in [0, count) on num_threads threads, which take the next index when they are done
+    template<typename function_type>
+    void parallel_for(size_t count, unsigned num_threads, function_type task)
+    {
+        std::atomic<size_t> next{0};
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < std::min<size_t>(num_threads, count); t++) {
+            workers.emplace_back([&] {
+                for (size_t i = next++; i < count; i = next++) {
+                    task(i);
+                }
+            });
+        }
+        for (auto & thread : workers) {
+            thread.join();
+        }
+    }
+
+    // The node farthest from the chosen landmarks, where closest holds the minimum distance from them. Nodes no landmark
+    // reaches count as farthest, since they are not covered at all, and ties go to the larger outdegree. Nodes without
+    // out-edges are skipped, and -1 is returned if no node is left.
+    template<IsDigraph graph_type>
+    typename graph_type::node_id_type farthest_node(const graph_type & G, std::vector<double> const & closest, std::vector<uint8_t> const & chosen)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        node_id_type best = -1;
+        for (node_id_type v = 0; v < G.num_nodes(); v++) {
+            if (chosen[v] || G.outdeg(v) == 0) {
+                continue;
+            }
+            if (best == node_id_type(-1) || closest[v] > closest[best] || (closest[v] == closest[best] && G.outdeg(v) > G.outdeg(best))) {
+                best = v;
+            }
+        }
+        return best;
+    }
+
+    // the avoid heuristic for the next landmark, given the distances from the landmarks chosen so far
+    template<HasInEdges graph_type>
+    typename graph_type::node_id_type avoid_node(const graph_type & G, std::vector<std::vector<double>> const & from_chosen,
+        std::vector<uint8_t> const & chosen, std::mt19937_64 & rng)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        // uniform_int_distribution is not defined for 8 bit types, so the root is drawn as a size_t
+        std::uniform_int_distribution<size_t> random_node(0, G.num_nodes() - 1);
+        node_id_type root = static_cast<node_id_type>(random_node(rng));
+        // a root without out-edges spans no tree, and in power-law graphs these are common
+        for (int attempt = 0; attempt < 16 && G.outdeg(root) == 0; attempt++) {
+            root = static_cast<node_id_type>(random_node(rng));
+        }
+        std::vector<double> from_root(G.num_nodes(), unreachable);
+        std::vector<node_id_type> parent(G.num_nodes(), root);
+        dijkstra(G, from_root, root, parent);
+
+        // the children of every node in the shortest path tree, and the tree nodes with parents before children
+        std::vector<node_id_type> order{root};
+        std::vector<std::vector<node_id_type>> children(G.num_nodes());
+        for (node_id_type v = 0; v < G.num_nodes(); v++) {
+            if (v != root && from_root[v] != unreachable) {
+                children[parent[v]].push_back(v);
+            }
+        }
+        for (size_t i = 0; i < order.size(); i++) {
+            order.insert(order.end(), children[order[i]].begin(), children[order[i]].end());
+        }
+
+        // a node weighs how much its distance from the root exceeds the lower bound of the landmarks, and a subtree
+        // containing a landmark counts as covered
+        std::vector<double> size(G.num_nodes(), 0);
+        std::vector<uint8_t> covered(G.num_nodes(), 0);
+        for (size_t i = order.size(); i-- > 0; ) {
+            const node_id_type v = order[i];
+            double bound = 0;
+            for (auto const & from_landmark : from_chosen) {
+                if (from_landmark[v] != unreachable && from_landmark[root] != unreachable) {
+                    bound = std::max(bound, from_landmark[v] - from_landmark[root]);
+                }
+            }
+            size[v] += std::max(0.0, from_root[v] - bound);
+            covered[v] |= chosen[v];
+            if (covered[v]) {
+                size[v] = 0;
+            }
+            if (v != root) {
+                size[parent[v]] += size[v];
+                covered[parent[v]] |= covered[v];
+            }
+        }
+
+        node_id_type node = root;
+        for (node_id_type v : order) {
+            if (size[v] > size[node]) {
+                node = v;
+            }
+        }
+        if (size[node] <= 0) {
+            return node_id_type(-1);
+        }
+        // descend to a leaf, always into the largest subtree
+        while (true) {
+            node_id_type next = node;
+            for (node_id_type child : children[node]) {
+                if (size[child] > 0 && (next == node || size[child] > size[next])) {
+                    next = child;
+                }
+            }
+            if (next == node) {
+                return node;
+            }
+            node = next;
+        }
+    }
+}
+
+// Picks num_landmarks landmarks and computes their tables. The selection depends on the landmarks chosen before and
+// runs one search after the other, the distances to the landmarks are computed afterwards on num_threads threads,
+// one per core if it is 0.
+template<HasInEdges graph_type>
+LandmarkTables<typename graph_type::node_id_type> compute_landmarks(const graph_type & G, size_t num_landmarks,
+    LandmarkSelection selection = LandmarkSelection::avoid, unsigned num_threads = 0, uint64_t seed = 1)
+{
+    using namespace alt_detail;
+    using node_id_type = typename graph_type::node_id_type;
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const size_t n = G.num_nodes();
+    num_landmarks = std::min(num_landmarks, n);
+    std::mt19937_64 rng(seed);
+
+    std::vector<node_id_type> landmarks;
+    std::vector<std::vector<double>> from_chosen;
+    std::vector<uint8_t> chosen(n, 0);
+    // the minimum distance from the chosen landmarks, for the farthest selection
+    std::vector<double> closest(n, unreachable);
+    while (landmarks.size() < num_landmarks) {
+        node_id_type next = -1;
+        if (selection == LandmarkSelection::avoid) {
+            // a random root may reach too little of the graph, then another one is tried
+            for (int attempt = 0; attempt < 4 && next == node_id_type(-1); attempt++) {
+                next = avoid_node(G, from_chosen, chosen, rng);
+            }
+        }
+        if (next == node_id_type(-1)) {
+            if (landmarks.empty() && n > 0) {
+                // the first landmark is the node farthest from the one of largest outdegree, which reaches much of the graph
+                node_id_type start = 0;
+                for (node_id_type v = 1; v < G.num_nodes(); v++) {
+                    if (G.outdeg(v) > G.outdeg(start)) {
+                        start = v;
+                    }
+                }
+                closest = distances<false>(G, start);
+            }
+            next = farthest_node(G, closest, chosen);
+            if (next == node_id_type(-1)) {
+                break;
+            }
+        }
+        landmarks.push_back(next);
+        chosen[next] = 1;
+        from_chosen.push_back(distances<false>(G, next));
+        for (size_t v = 0; v < n; v++) {
+            closest[v] = landmarks.size() == 1 ? from_chosen.back()[v] : std::min(closest[v], from_chosen.back()[v]);
+        }
+    }
+
+    LandmarkTables<node_id_type> tables;
+    tables.landmarks = landmarks;
+    tables.num_nodes = n;
+    tables.num_edges = G.num_edges();
+    const size_t k = landmarks.size();
+    tables.from_landmark.resize(n * k);
+    tables.to_landmark.resize(n * k);
+    for (size_t i = 0; i < k; i++) {
+        for (size_t v = 0; v < n; v++) {
+            tables.from_landmark[v * k + i] = from_chosen[i][v];
+        }
+    }
+    from_chosen.clear();
+    // builds the in-edge index once, before the threads share the graph
+    if (n > 0) {
+        G.inAdjList(0);
+    }
+    parallel_for(k, num_threads, [&](size_t i) {
+        const std::vector<double> to_landmark = distances<true>(G, landmarks[i]);
+        for (size_t v = 0; v < n; v++) {
+            tables.to_landmark[v * k + i] = to_landmark[v];
+        }
+    });
+    return tables;
+}
+
+// Layout of a file, all values in native byte order:
+//   LandmarkFileHeader
+//   landmarks      (num_landmarks node ids)
+//   from_landmark  (num_nodes * num_landmarks doubles)
+//   to_landmark    (num_nodes * num_landmarks doubles)
+constexpr char landmark_file_magic[8] = {'L', 'A', 'N', 'D', 'M', 'A', 'R', 'K'};
+constexpr uint32_t landmark_file_version = 1;
+
+struct LandmarkFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t id_code; // type of the node ids, see binary_type_code
+    uint32_t reserved;
+    uint64_t num_nodes;
+    uint64_t num_edges;
+    uint64_t num_landmarks;
+};
+
+static_assert(sizeof(LandmarkFileHeader) == 48);
+
+template<typename node_id_type>
+void write_landmarks(LandmarkTables<node_id_type> const & tables, std::string const & path)
+{
+    LandmarkFileHeader header{};
+    std::memcpy(header.magic, landmark_file_magic, sizeof(header.magic));
+    header.version = landmark_file_version;
+    header.byte_order = binary_graph_byte_order;
+    header.id_code = binary_type_code<node_id_type>();
+    header.num_nodes = tables.num_nodes;
+    header.num_edges = tables.num_edges;
+    header.num_landmarks = tables.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("cannot open " + path + " for writing");
+    }
+    auto write_array = [&out](auto const & values) {
+        out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(values[0])));
+    };
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    write_array(tables.landmarks);
+    write_array(tables.from_landmark);
+    write_array(tables.to_landmark);
+    if (!out) {
+        throw std::runtime_error("error while writing " + path);
+    }
+}
+
+template<typename node_id_type = int>
+LandmarkTables<node_id_type> read_landmarks(std::string const & path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    LandmarkFileHeader header{};
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, landmark_file_magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path + " is not a landmark file");
+    }
+    if (header.version == 0 || header.version > landmark_file_version) {
+        throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.version));
+    }
+    if (header.byte_order != binary_graph_byte_order) {
+        throw std::runtime_error(path + " was written on an incompatible platform");
+    }
+    if (header.id_code != binary_type_code<node_id_type>()) {
+        throw std::runtime_error(path + " uses another node id type than requested");
+    }
+    // the sizes come from the file, so they are checked against its length before anything is allocated. Every
+    // landmark takes its id and two distances per node.
+    in.seekg(0, std::ios::end);
+    const uint64_t data_size = static_cast<uint64_t>(in.tellg()) - sizeof(header);
+    in.seekg(sizeof(header));
+    const uint64_t n = header.num_nodes;
+    const uint64_t k = header.num_landmarks;
+    bool consistent = n <= static_cast<uint64_t>(std::numeric_limits<node_id_type>::max()) && k <= n
+        && n <= (std::numeric_limits<uint64_t>::max() - sizeof(node_id_type)) / (2 * sizeof(double));
+    if (consistent) {
+        const uint64_t per_landmark = sizeof(node_id_type) + 2 * sizeof(double) * n;
+        consistent = k == 0 ? data_size == 0 : data_size % k == 0 && data_size / k == per_landmark;
+    }
+    if (!in || !consistent) {
+        throw std::runtime_error(path + " has sizes that do not match its length");
+    }
+
+    LandmarkTables<node_id_type> tables;
+    tables.num_nodes = header.num_nodes;
+    tables.num_edges = header.num_edges;
+    tables.landmarks.resize(header.num_landmarks);
+    tables.from_landmark.resize(header.num_nodes * header.num_landmarks);
+    tables.to_landmark.resize(header.num_nodes * header.num_landmarks);
+    auto read_array = [&in](auto & values) {
+        in.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(values[0])));
+    };
+    read_array(tables.landmarks);
+    read_array(tables.from_landmark);
+    read_array(tables.to_landmark);
+    if (!in) {
+        throw std::runtime_error(path + " is truncated");
+    }
+    return tables;
+}
+
+// Answers many queries on one graph with the same tables, resetting only the labels touched by the previous query.
+// It keeps its own tables, so that they can come straight from compute_landmarks or read_landmarks; move them in to
+// avoid the copy.
+template<IsDigraph graph_type, unsigned arity = 4>
+class ALT
+{
+public:
+    using node_id_type = typename graph_type::node_id_type;
+
+    ALT(const graph_type & G, LandmarkTables<node_id_type> landmark_tables)
+        : G(G), tables(std::move(landmark_tables)), k(tables.size()), distances(G.num_nodes(), alt_detail::unreachable),
+          parent(G.num_nodes()), potentials(G.num_nodes(), unknown), heap(G.num_nodes())
+    {
+        if (tables.num_nodes != static_cast<uint64_t>(G.num_nodes()) || tables.num_edges != static_cast<uint64_t>(G.num_edges())) {
+            throw std::invalid_argument("the landmark tables belong to another graph");
+        }
+        const size_t entries = static_cast<size_t>(tables.num_nodes) * k;
+        if (tables.from_landmark.size() != entries || tables.to_landmark.size() != entries) {
+            throw std::invalid_argument("the landmark tables do not hold a distance for every node and landmark");
+        }
+    }
+
+    ShortestPath<node_id_type> query(node_id_type source, node_id_type target)
+    {
+        for (node_id_type node : touched) {
+            distances[node] = alt_detail::unreachable;
+            potentials[node] = unknown;
+        }
+        touched.clear();
+        heap.clear();
+        this->target = target;
+
+        ShortestPath<node_id_type> result;
+        if (potential(source) == alt_detail::unreachable) {
+            return result;
+        }
+        distances[source] = 0;
+        parent[source] = source;
+        heap.push(source, potential(source));
+        while (!heap.empty()) {
+            const node_id_type node = heap.pop().first;
+            result.settled++;
+            if (node == target) {
+                break;
+            }
+            for (const auto & edge : G.adjList(node)) {
+                const double candidate = distances[node] + edge.weight;
+                if (candidate < distances[edge.to]) {
+                    const double bound = potential(edge.to);
+                    if (bound == alt_detail::unreachable) {
+                        continue;
+                    }
+                    distances[edge.to] = candidate;
+                    parent[edge.to] = node;
+                    // rounding may make a potential slightly inconsistent, then a settled node is simply pushed again
+                    heap.push_or_decrease(edge.to, candidate + bound);
+                }
+            }
+        }
+        if (distances[target] == alt_detail::unreachable) {
+            return result;
+        }
+        result.distance = distances[target];
+        for (node_id_type node = target; node != source; node = parent[node]) {
+            result.path.push_back(node);
+        }
+        result.path.push_back(source);
+        std::reverse(result.path.begin(), result.path.end());
+        return result;
+    }
+
+private:
+    static constexpr double unknown = -1;
+
+    const graph_type & G;
+    const LandmarkTables<node_id_type> tables;
+    const size_t k;
+    node_id_type target = 0;
+    std::vector<double> distances;
+    std::vector<node_id_type> parent;
+    // the potentials of the current target, computed when a node is first reached
+    std::vector<double> potentials;
+    IndexedDAryHeap<double, node_id_type, arity> heap;
+    std::vector<node_id_type> touched;
+
+    // the best lower bound on d(node, target), or unreachable if some landmark proves that there is no path
+    double potential(node_id_type node)
+    {
+        if (potentials[node] != unknown) {
+            return potentials[node];
+        }
+        using alt_detail::unreachable;
+        // without landmarks the tables are empty, every bound is 0 and the search is Dijkstra's
+        const double * from_node = tables.from_landmark.data() + static_cast<size_t>(node) * k;
+        const double * to_node = tables.to_landmark.data() + static_cast<size_t>(node) * k;
+        const double * from_target = tables.from_landmark.data() + static_cast<size_t>(target) * k;
+        const double * to_target = tables.to_landmark.data() + static_cast<size_t>(target) * k;
+        double bound = 0;
+        for (size_t i = 0; i < k; i++) {
+            // a path from node to the target would extend a path from the target to the landmark, or one from the landmark to node
+            if ((to_target[i] != unreachable && to_node[i] == unreachable) || (from_node[i] != unreachable && from_target[i] == unreachable)) {
+                bound = unreachable;
+                break;
+            }
+            if (to_node[i] != unreachable && to_target[i] != unreachable) {
+                bound = std::max(bound, to_node[i] - to_target[i]);
+            }
+            if (from_target[i] != unreachable && from_node[i] != unreachable) {
+                bound = std::max(bound, from_target[i] - from_node[i]);
+            }
+        }
+        touched.push_back(node);
+        potentials[node] = bound;
+        return bound;
+    }
+};
+
+#endif //SHORTEST_PATHS_ALT_H
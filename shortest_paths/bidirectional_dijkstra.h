@@ -0,0 +1,150 @@
+// Bidirectional Dijkstra for point-to-point queries in a directed weighted graph with nonnegative weights. A forward
+// search from the source on the out-edges and a backward search from the target on the in-edges run alternately, always
+// advancing the one whose next node is closer, and every edge reaching a node labelled by the other search is a
+// candidate connection. Once the two smallest heap keys add up to at least the best connection, it is a shortest path.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_BIDIRECTIONAL_DIJKSTRA_H
+#define SHORTEST_PATHS_BIDIRECTIONAL_DIJKSTRA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/d_ary_heap.h"
+
+template<typename node_id_type>
+struct ShortestPath
+{
+    // std::numeric_limits<double>::max() and an empty path if the target cannot be reached
+    double distance = std::numeric_limits<double>::max();
+    // from the source to the target, both included
+    std::vector<node_id_type> path;
+    // the number of nodes popped by both searches together
+    size_t settled = 0;
+};
+
+// Answers many queries on one graph. Only the labels touched by a query are reset before the next one, so a query that
+// settles few nodes also takes little time on a large graph.
+template<HasInEdges graph_type, unsigned arity = 4>
+class BidirectionalDijkstra
+{
+public:
+    using node_id_type = typename graph_type::node_id_type;
+
+    explicit BidirectionalDijkstra(const graph_type & G) : G(G), forward(G), backward(G)
+    {
+    }
+
+    ShortestPath<node_id_type> query(node_id_type source, node_id_type target)
+    {
+        forward.reset();
+        backward.reset();
+        ShortestPath<node_id_type> result;
+        forward.label(source, 0, source);
+        backward.label(target, 0, target);
+        if (source == target) {
+            result.distance = 0;
+            result.path.push_back(source);
+            return result;
+        }
+        node_id_type meeting = source;
+        while (!forward.heap.empty() && !backward.heap.empty()) {
+            const double forward_key = forward.heap.top().second;
+            const double backward_key = backward.heap.top().second;
+            if (forward_key + backward_key >= result.distance) {
+                break;
+            }
+            result.settled++;
+            if (forward_key <= backward_key) {
+                const node_id_type node = forward.heap.pop().first;
+                for (const auto & edge : G.adjList(node)) {
+                    forward.relax(edge.to, forward_key + edge.weight, node, backward, result.distance, meeting);
+                }
+            }
+            else {
+                const node_id_type node = backward.heap.pop().first;
+                for (const auto & edge : G.inAdjList(node)) {
+                    backward.relax(edge.from, backward_key + edge.weight, node, forward, result.distance, meeting);
+                }
+            }
+        }
+        if (result.distance == std::numeric_limits<double>::max()) {
+            return result;
+        }
+        for (node_id_type node = meeting; node != source; node = forward.parent[node]) {
+            result.path.push_back(node);
+        }
+        result.path.push_back(source);
+        std::reverse(result.path.begin(), result.path.end());
+        for (node_id_type node = meeting; node != target; ) {
+            node = backward.parent[node];
+            result.path.push_back(node);
+        }
+        return result;
+    }
+
+private:
+    struct Search
+    {
+        std::vector<double> distances;
+        // the previous node on the path from the source, or the next one on the path to the target
+        std::vector<node_id_type> parent;
+        IndexedDAryHeap<double, node_id_type, arity> heap;
+        std::vector<node_id_type> touched;
+
+        explicit Search(const graph_type & G)
+            : distances(G.num_nodes(), std::numeric_limits<double>::max()), parent(G.num_nodes()), heap(G.num_nodes())
+        {
+        }
+
+        void reset()
+        {
+            for (node_id_type node : touched) {
+                distances[node] = std::numeric_limits<double>::max();
+            }
+            touched.clear();
+            heap.clear();
+        }
+
+        void label(node_id_type node, double distance, node_id_type from)
+        {
+            if (distances[node] == std::numeric_limits<double>::max()) {
+                touched.push_back(node);
+            }
+            distances[node] = distance;
+            parent[node] = from;
+            heap.push_or_decrease(node, distance);
+        }
+
+        // a node labelled by both searches closes a path of length the sum of both labels
+        void relax(node_id_type node, double candidate, node_id_type from, Search const & other, double & best, node_id_type & meeting)
+        {
+            if (!(candidate < distances[node])) {
+                return;
+            }
+            label(node, candidate, from);
+            if (other.distances[node] != std::numeric_limits<double>::max() && candidate + other.distances[node] < best) {
+                best = candidate + other.distances[node];
+                meeting = node;
+            }
+        }
+    };
+
+    const graph_type & G;
+    Search forward;
+    Search backward;
+};
+
+// a single query, for many queries on the same graph reuse a BidirectionalDijkstra
+template<HasInEdges graph_type>
+ShortestPath<typename graph_type::node_id_type> bidirectional_dijkstra(const graph_type & G, const typename graph_type::node_id_type source,
+    const typename graph_type::node_id_type target)
+{
+    BidirectionalDijkstra<graph_type> search(G);
+    return search.query(source, target);
+}
+
+#endif //SHORTEST_PATHS_BIDIRECTIONAL_DIJKSTRA_H
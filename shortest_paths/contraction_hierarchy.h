@@ -0,0 +1,512 @@
+// Contraction hierarchies for point-to-point queries in a directed weighted graph with nonnegative weights.
+// Preprocessing contracts the nodes one after the other, cheapest first by edge difference: a contracted node leaves
+// the graph, and for every path u -> v -> w through it that is the only shortest one, a witness search finds no other,
+// a shortcut u -> w replaces it. The rank of a node is its position in that order. A shortest path then always has a
+// representation that first climbs and then descends in rank, so a query runs two Dijkstra searches that only ever go
+// up: the forward one from the source on the upward edges, the backward one from the target on the downward edges.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_CONTRACTION_HIERARCHY_H
+#define SHORTEST_PATHS_CONTRACTION_HIERARCHY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/bidirectional_dijkstra.h"
+#include "shortest_paths/d_ary_heap.h"
+
+namespace contraction_hierarchy_detail
+{
+    constexpr double unreachable = std::numeric_limits<double>::max();
+
+    // the remaining graph during the contraction, as out- and in-lists without parallel edges
+    template<typename node_id_type>
+    class Contractor
+    {
+    public:
+        struct OverlayEdge
+        {
+            node_id_type node;
+            double weight;
+            // the contracted node a shortcut bypasses, or -1 for an edge of the input graph
+            node_id_type middle;
+        };
+
+        std::vector<std::vector<OverlayEdge>> out;
+        std::vector<std::vector<OverlayEdge>> in;
+        // the edges of a node when it was contracted, which all lead to nodes of higher rank
+        std::vector<std::vector<OverlayEdge>> upward;
+        std::vector<std::vector<OverlayEdge>> downward;
+        std::vector<node_id_type> order;
+        size_t shortcuts = 0;
+
+        template<IsDigraph graph_type>
+        Contractor(const graph_type & G, size_t witness_limit)
+            : out(G.num_nodes()), in(G.num_nodes()), upward(G.num_nodes()), downward(G.num_nodes()), witness_limit(witness_limit),
+              contracted_neighbours(G.num_nodes(), 0), distances(G.num_nodes(), unreachable), is_target(G.num_nodes(), 0),
+              slot(G.num_nodes(), 0), heap(G.num_nodes())
+        {
+            std::vector<OverlayEdge> edges;
+            for (node_id_type i = 0; i < G.num_nodes(); i++) {
+                edges.clear();
+                for (const auto & edge : G.adjList(i)) {
+                    // self loops are never part of a shortest path
+                    if (edge.to != i) {
+                        edges.push_back({edge.to, static_cast<double>(edge.weight), node_id_type(-1)});
+                    }
+                }
+                merge(out[i], edges);
+            }
+            // the out-lists hold no parallel edges anymore, so neither do the in-lists built from them
+            for (size_t i = 0; i < out.size(); i++) {
+                for (const auto & edge : out[i]) {
+                    in[edge.node].push_back({static_cast<node_id_type>(i), edge.weight, edge.middle});
+                }
+            }
+        }
+
+        void contract_all()
+        {
+            const node_id_type n = static_cast<node_id_type>(out.size());
+            IndexedDAryHeap<int, node_id_type> queue(n);
+            for (node_id_type v = 0; v < n; v++) {
+                queue.push(v, priority(v));
+            }
+            while (!queue.empty()) {
+                // contracting a node changes the priorities of its neighbours, but instead of recomputing them all, only
+                // the top is recomputed and contracted if it stays the smallest, which is much faster at hardly any
+                // cost in the number of shortcuts
+                const node_id_type v = queue.top().first;
+                const int current = priority(v);
+                if (current > queue.top().second) {
+                    queue.change_key(v, current);
+                    continue;
+                }
+                // the shortcuts found by priority(v) are the ones contract(v) adds
+                queue.pop();
+                contract(v);
+            }
+        }
+
+    private:
+        // a witness search gives up after settling this many nodes and the shortcut is added, which is never wrong
+        const size_t witness_limit;
+        std::vector<int> contracted_neighbours;
+        std::vector<double> distances;
+        std::vector<node_id_type> touched;
+        // marks the out-neighbours of the node whose witnesses are searched
+        std::vector<uint8_t> is_target;
+        // during merge, one plus the position of the edge to a node in the list merged into, 0 if there is none
+        std::vector<size_t> slot;
+        IndexedDAryHeap<double, node_id_type> heap;
+        // the shortcuts u -> w of the node the last priority was computed for, grouped by u
+        std::vector<std::tuple<node_id_type, node_id_type, double>> found;
+        std::vector<OverlayEdge> batch;
+
+        // adds every edge of added to edges that has no edge to the same node there yet, and replaces the heavier ones
+        // that have, in time linear in the size of both, however many edges a hub node has collected
+        void merge(std::vector<OverlayEdge> & edges, std::vector<OverlayEdge> const & added)
+        {
+            for (size_t i = 0; i < edges.size(); i++) {
+                slot[edges[i].node] = i + 1;
+            }
+            for (const auto & edge : added) {
+                if (slot[edge.node] == 0) {
+                    edges.push_back(edge);
+                    slot[edge.node] = edges.size();
+                }
+                else if (edge.weight < edges[slot[edge.node] - 1].weight) {
+                    edges[slot[edge.node] - 1] = edge;
+                }
+            }
+            for (const auto & edge : edges) {
+                slot[edge.node] = 0;
+            }
+        }
+
+        static void erase(std::vector<OverlayEdge> & edges, node_id_type node)
+        {
+            for (auto & edge : edges) {
+                if (edge.node == node) {
+                    edge = edges.back();
+                    edges.pop_back();
+                    return;
+                }
+            }
+        }
+
+        // Dijkstra from source in the remaining graph without avoided, until it has settled all out-neighbours of
+        // avoided, passed distance limit or settled witness_limit nodes
+        void witness_search(node_id_type source, node_id_type avoided, double limit)
+        {
+            size_t pending = 0;
+            for (const auto & edge : out[avoided]) {
+                pending += edge.node != source;
+                is_target[edge.node] = 1;
+            }
+            distances[source] = 0;
+            touched.push_back(source);
+            heap.push(source, 0);
+            size_t settled = 0;
+            while (!heap.empty() && pending > 0) {
+                const auto [node, distance] = heap.pop();
+                if (distance > limit || ++settled > witness_limit) {
+                    break;
+                }
+                if (is_target[node] && node != source) {
+                    pending--;
+                }
+                for (const auto & edge : out[node]) {
+                    const double candidate = distance + edge.weight;
+                    if (edge.node != avoided && candidate < distances[edge.node]) {
+                        if (distances[edge.node] == unreachable) {
+                            touched.push_back(edge.node);
+                        }
+                        distances[edge.node] = candidate;
+                        heap.push_or_decrease(edge.node, candidate);
+                    }
+                }
+            }
+            heap.clear();
+            for (const auto & edge : out[avoided]) {
+                is_target[edge.node] = 0;
+            }
+        }
+
+        // calls shortcut(u, w, weight) for every path u -> v -> w without a witness
+        template<typename function_type>
+        void for_each_shortcut(node_id_type v, function_type && shortcut)
+        {
+            if (out[v].empty()) {
+                return;
+            }
+            double max_out = 0;
+            for (const auto & edge : out[v]) {
+                max_out = std::max(max_out, edge.weight);
+            }
+            for (const auto & in_edge : in[v]) {
+                witness_search(in_edge.node, v, in_edge.weight + max_out);
+                for (const auto & out_edge : out[v]) {
+                    const double via = in_edge.weight + out_edge.weight;
+                    if (out_edge.node != in_edge.node && distances[out_edge.node] > via) {
+                        shortcut(in_edge.node, out_edge.node, via);
+                    }
+                }
+                for (node_id_type node : touched) {
+                    distances[node] = unreachable;
+                }
+                touched.clear();
+            }
+        }
+
+        // the edge difference, shortcuts added minus edges removed with the shortcuts counted twice, plus the contracted
+        // neighbours, which spreads the contraction evenly over the graph. Keeps the shortcuts, so that contracting v
+        // right after needs no second round of witness searches.
+        int priority(node_id_type v)
+        {
+            found.clear();
+            for_each_shortcut(v, [this](node_id_type u, node_id_type w, double weight) { found.emplace_back(u, w, weight); });
+            return 2 * static_cast<int>(found.size()) - static_cast<int>(out[v].size() + in[v].size()) + contracted_neighbours[v];
+        }
+
+        // contracts v with the shortcuts of the last priority(v), which must be the last call of priority
+        void contract(node_id_type v)
+        {
+            for (const auto & edge : out[v]) {
+                erase(in[edge.node], v);
+                contracted_neighbours[edge.node]++;
+            }
+            for (const auto & edge : in[v]) {
+                erase(out[edge.node], v);
+                contracted_neighbours[edge.node]++;
+            }
+            // the shortcuts come grouped by tail, one merge per out-list, then grouped by head, one merge per in-list
+            for (size_t first = 0, last = 0; first < found.size(); first = last) {
+                const node_id_type u = std::get<0>(found[first]);
+                batch.clear();
+                for (; last < found.size() && std::get<0>(found[last]) == u; last++) {
+                    batch.push_back({std::get<1>(found[last]), std::get<2>(found[last]), v});
+                }
+                const size_t before = out[u].size();
+                merge(out[u], batch);
+                shortcuts += out[u].size() - before;
+            }
+            std::sort(found.begin(), found.end(), [](auto const & a, auto const & b) { return std::get<1>(a) < std::get<1>(b); });
+            for (size_t first = 0, last = 0; first < found.size(); first = last) {
+                const node_id_type w = std::get<1>(found[first]);
+                batch.clear();
+                for (; last < found.size() && std::get<1>(found[last]) == w; last++) {
+                    batch.push_back({std::get<0>(found[last]), std::get<2>(found[last]), v});
+                }
+                merge(in[w], batch);
+            }
+            upward[v] = std::move(out[v]);
+            downward[v] = std::move(in[v]);
+            out[v] = {};
+            in[v] = {};
+            order.push_back(v);
+        }
+    };
+}
+
+template<typename node_id_t = int>
+class ContractionHierarchy
+{
+public:
+    using node_id_type = node_id_t;
+
+    // edges of the nodes in rank order. In the upward graph the edges of a node lead to its higher ranked heads, in the
+    // downward graph they come from its higher ranked tails, and node holds that tail.
+    struct SearchGraph
+    {
+        std::vector<size_t> offsets;
+        std::vector<node_id_type> nodes;
+        std::vector<double> weights;
+        // the rank of the node a shortcut bypasses, or -1 for an edge of the input graph
+        std::vector<node_id_type> middles;
+
+        size_t memory_bytes() const
+        {
+            return offsets.size() * sizeof(size_t) + nodes.size() * sizeof(node_id_type) + weights.size() * sizeof(double)
+                + middles.size() * sizeof(node_id_type);
+        }
+    };
+
+    // witness_limit bounds the nodes settled per witness search, a smaller one speeds up the preprocessing at the
+    // cost of unnecessary shortcuts
+    template<IsDigraph graph_type>
+    explicit ContractionHierarchy(const graph_type & G, size_t witness_limit = 500) : ranks(G.num_nodes()), nodes(G.num_nodes())
+    {
+        static_assert(std::is_same_v<typename graph_type::node_id_type, node_id_type>);
+        contraction_hierarchy_detail::Contractor<node_id_type> contractor(G, witness_limit);
+        contractor.contract_all();
+        shortcuts = contractor.shortcuts;
+        for (size_t r = 0; r < contractor.order.size(); r++) {
+            nodes[r] = contractor.order[r];
+            ranks[contractor.order[r]] = static_cast<node_id_type>(r);
+        }
+        build(contractor.upward, upward);
+        build(contractor.downward, downward);
+    }
+
+    node_id_type num_nodes() const
+    {
+        return static_cast<node_id_type>(nodes.size());
+    }
+
+    size_t num_shortcuts() const
+    {
+        return shortcuts;
+    }
+
+    size_t memory_bytes() const
+    {
+        return upward.memory_bytes() + downward.memory_bytes() + (ranks.size() + nodes.size()) * sizeof(node_id_type);
+    }
+
+    node_id_type rank(node_id_type node) const
+    {
+        return ranks[node];
+    }
+
+    node_id_type node_at(node_id_type rank) const
+    {
+        return nodes[rank];
+    }
+
+    SearchGraph const & upward_graph() const
+    {
+        return upward;
+    }
+
+    SearchGraph const & downward_graph() const
+    {
+        return downward;
+    }
+
+private:
+    SearchGraph upward;
+    SearchGraph downward;
+    std::vector<node_id_type> ranks;
+    std::vector<node_id_type> nodes;
+    size_t shortcuts = 0;
+
+    template<typename edge_lists>
+    void build(edge_lists const & lists, SearchGraph & graph)
+    {
+        graph.offsets.assign(nodes.size() + 1, 0);
+        for (size_t r = 0; r < nodes.size(); r++) {
+            graph.offsets[r + 1] = graph.offsets[r] + lists[nodes[r]].size();
+        }
+        graph.nodes.reserve(graph.offsets.back());
+        graph.weights.reserve(graph.offsets.back());
+        graph.middles.reserve(graph.offsets.back());
+        for (size_t r = 0; r < nodes.size(); r++) {
+            for (const auto & edge : lists[nodes[r]]) {
+                graph.nodes.push_back(ranks[edge.node]);
+                graph.weights.push_back(edge.weight);
+                graph.middles.push_back(edge.middle == node_id_type(-1) ? node_id_type(-1) : ranks[edge.middle]);
+            }
+        }
+    }
+};
+
+// Answers many queries on one hierarchy, resetting only the labels touched by the previous query. A node is stalled,
+// its edges are not relaxed, if an edge from a higher ranked node already labelled by the same search shows that its
+// label is not a shortest distance.
+template<typename node_id_type = int, unsigned arity = 4>
+class ContractionHierarchyQuery
+{
+public:
+    explicit ContractionHierarchyQuery(ContractionHierarchy<node_id_type> const & CH)
+        : CH(CH), forward(CH.num_nodes()), backward(CH.num_nodes())
+    {
+    }
+
+    ShortestPath<node_id_type> query(node_id_type source, node_id_type target)
+    {
+        using contraction_hierarchy_detail::unreachable;
+        forward.reset();
+        backward.reset();
+        ShortestPath<node_id_type> result;
+        const node_id_type from = CH.rank(source);
+        const node_id_type to = CH.rank(target);
+        forward.label(from, 0, from, none);
+        backward.label(to, 0, to, none);
+        node_id_type meeting = none;
+        while (true) {
+            const bool forward_active = !forward.heap.empty() && forward.heap.top().second < result.distance;
+            const bool backward_active = !backward.heap.empty() && backward.heap.top().second < result.distance;
+            if (!forward_active && !backward_active) {
+                break;
+            }
+            const bool go_forward = forward_active && (!backward_active || forward.heap.top().second <= backward.heap.top().second);
+            Search & search = go_forward ? forward : backward;
+            Search & other = go_forward ? backward : forward;
+            // the forward search climbs the upward edges, the backward one the downward edges, and each one stalls
+            // on the edges of the other direction
+            auto const & climb = go_forward ? CH.upward_graph() : CH.downward_graph();
+            auto const & stall = go_forward ? CH.downward_graph() : CH.upward_graph();
+
+            const auto [node, distance] = search.heap.pop();
+            result.settled++;
+            if (other.distances[node] != unreachable && distance + other.distances[node] < result.distance) {
+                result.distance = distance + other.distances[node];
+                meeting = node;
+            }
+            bool stalled = false;
+            for (size_t e = stall.offsets[node]; e < stall.offsets[node + 1] && !stalled; e++) {
+                const node_id_type higher = stall.nodes[e];
+                stalled = search.distances[higher] != unreachable && search.distances[higher] + stall.weights[e] < distance;
+            }
+            if (stalled) {
+                continue;
+            }
+            for (size_t e = climb.offsets[node]; e < climb.offsets[node + 1]; e++) {
+                const node_id_type higher = climb.nodes[e];
+                const double candidate = distance + climb.weights[e];
+                if (candidate < search.distances[higher]) {
+                    search.label(higher, candidate, node, e);
+                }
+            }
+        }
+        if (meeting == none) {
+            return result;
+        }
+
+        // the upward edges from the source to the meeting node, then the downward edges from there to the target
+        std::vector<std::tuple<node_id_type, node_id_type, node_id_type>> edges;
+        for (node_id_type node = meeting; node != from; node = forward.parent[node]) {
+            edges.emplace_back(forward.parent[node], node, CH.upward_graph().middles[forward.edge[node]]);
+        }
+        std::reverse(edges.begin(), edges.end());
+        for (node_id_type node = meeting; node != to; node = backward.parent[node]) {
+            edges.emplace_back(node, backward.parent[node], CH.downward_graph().middles[backward.edge[node]]);
+        }
+        result.path.push_back(source);
+        for (const auto & [tail, head, middle] : edges) {
+            unpack(tail, head, middle, result.path);
+        }
+        return result;
+    }
+
+private:
+    static constexpr node_id_type none = -1;
+
+    struct Search
+    {
+        std::vector<double> distances;
+        // the previous node towards the start of the search, by rank, and the index of the edge from it
+        std::vector<node_id_type> parent;
+        std::vector<size_t> edge;
+        IndexedDAryHeap<double, node_id_type, arity> heap;
+        std::vector<node_id_type> touched;
+
+        explicit Search(node_id_type n)
+            : distances(n, contraction_hierarchy_detail::unreachable), parent(n), edge(n), heap(n)
+        {
+        }
+
+        void reset()
+        {
+            for (node_id_type node : touched) {
+                distances[node] = contraction_hierarchy_detail::unreachable;
+            }
+            touched.clear();
+            heap.clear();
+        }
+
+        void label(node_id_type node, double distance, node_id_type from, size_t via)
+        {
+            if (distances[node] == contraction_hierarchy_detail::unreachable) {
+                touched.push_back(node);
+            }
+            distances[node] = distance;
+            parent[node] = from;
+            edge[node] = via;
+            heap.push_or_decrease(node, distance);
+        }
+    };
+
+    ContractionHierarchy<node_id_type> const & CH;
+    Search forward;
+    Search backward;
+    // the shortcuts still to unpack, as tail, head and middle
+    std::vector<std::tuple<node_id_type, node_id_type, node_id_type>> stack;
+
+    // the middle of a shortcut is ranked below both ends, so the edge from the tail to it is a downward one stored
+    // with the middle, and the edge from it to the head an upward one stored there as well
+    static node_id_type middle_of(typename ContractionHierarchy<node_id_type>::SearchGraph const & graph, node_id_type at, node_id_type other)
+    {
+        for (size_t e = graph.offsets[at]; e < graph.offsets[at + 1]; e++) {
+            if (graph.nodes[e] == other) {
+                return graph.middles[e];
+            }
+        }
+        return none;
+    }
+
+    // appends the nodes after tail on the path the edge tail -> head stands for, in original ids
+    void unpack(node_id_type tail, node_id_type head, node_id_type middle, std::vector<node_id_type> & path)
+    {
+        stack.emplace_back(tail, head, middle);
+        while (!stack.empty()) {
+            const auto [u, w, m] = stack.back();
+            stack.pop_back();
+            if (m == none) {
+                path.push_back(CH.node_at(w));
+                continue;
+            }
+            // the first half has to be unpacked first, so it goes on the stack last
+            stack.emplace_back(m, w, middle_of(CH.upward_graph(), m, w));
+            stack.emplace_back(u, m, middle_of(CH.downward_graph(), m, u));
+        }
+    }
+};
+
+#endif //SHORTEST_PATHS_CONTRACTION_HIERARCHY_H
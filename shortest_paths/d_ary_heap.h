@@ -0,0 +1,179 @@
+// Indexed d-ary min-heap with decrease-key. Every item, a number below the capacity such as a node id, is in the heap
+// at most once, and a position map finds it again when its key decreases. A larger arity makes the tree flatter, so that
+// decrease-key, the common operation in Dijkstra's algorithm, moves through fewer levels, while pop compares more children.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_D_ARY_HEAP_H
+#define SHORTEST_PATHS_D_ARY_HEAP_H
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+template<typename key_type, typename item_type = int, unsigned arity = 4>
+class IndexedDAryHeap
+{
+    static_assert(arity >= 2);
+
+public:
+    // items have to be smaller than capacity
+    explicit IndexedDAryHeap(size_t capacity) : positions(capacity, absent)
+    {
+    }
+
+    bool empty() const
+    {
+        return items.empty();
+    }
+
+    size_t size() const
+    {
+        return items.size();
+    }
+
+    bool contains(item_type item) const
+    {
+        return positions[item] != absent;
+    }
+
+    // the current key of an item in the heap
+    key_type key(item_type item) const
+    {
+        return keys[positions[item]];
+    }
+
+    void push(item_type item, key_type key)
+    {
+        items.push_back(item);
+        keys.push_back(key);
+        positions[item] = items.size() - 1;
+        sift_up(items.size() - 1);
+    }
+
+    // key must not be larger than the current key of item
+    void decrease_key(item_type item, key_type key)
+    {
+        const size_t pos = positions[item];
+        keys[pos] = key;
+        sift_up(pos);
+    }
+
+    // pushes item, or decreases its key if it is already in the heap with a larger one. Returns whether anything changed.
+    bool push_or_decrease(item_type item, key_type key)
+    {
+        if (!contains(item)) {
+            push(item, key);
+            return true;
+        }
+        if (key < keys[positions[item]]) {
+            decrease_key(item, key);
+            return true;
+        }
+        return false;
+    }
+
+    // sets the key of an item in the heap, which may also be larger than its current one
+    void change_key(item_type item, key_type key)
+    {
+        const size_t pos = positions[item];
+        const bool decreases = key < keys[pos];
+        keys[pos] = key;
+        if (decreases) {
+            sift_up(pos);
+        }
+        else {
+            sift_down(pos);
+        }
+    }
+
+    // an item of minimum key together with that key
+    std::pair<item_type, key_type> top() const
+    {
+        return {items.front(), keys.front()};
+    }
+
+    std::pair<item_type, key_type> pop()
+    {
+        const std::pair<item_type, key_type> result = top();
+        positions[result.first] = absent;
+        const item_type last_item = items.back();
+        const key_type last_key = keys.back();
+        items.pop_back();
+        keys.pop_back();
+        if (!items.empty()) {
+            place(0, last_item, last_key);
+            sift_down(0);
+        }
+        return result;
+    }
+
+    void clear()
+    {
+        for (item_type item : items) {
+            positions[item] = absent;
+        }
+        items.clear();
+        keys.clear();
+    }
+
+private:
+    static constexpr size_t absent = std::numeric_limits<size_t>::max();
+
+    // the heap in level order. Keys are kept apart from the items, so that the children compared in sift_down
+    // sit next to each other in memory.
+    std::vector<item_type> items;
+    std::vector<key_type> keys;
+    std::vector<size_t> positions;
+
+    void place(size_t pos, item_type item, key_type key)
+    {
+        items[pos] = item;
+        keys[pos] = key;
+        positions[item] = pos;
+    }
+
+    // both sifts move the entries they pass over by one level and write the moving entry only once, at its final position
+    void sift_up(size_t pos)
+    {
+        const item_type item = items[pos];
+        const key_type key = keys[pos];
+        while (pos > 0) {
+            const size_t parent = (pos - 1) / arity;
+            if (!(key < keys[parent])) {
+                break;
+            }
+            place(pos, items[parent], keys[parent]);
+            pos = parent;
+        }
+        place(pos, item, key);
+    }
+
+    void sift_down(size_t pos)
+    {
+        const item_type item = items[pos];
+        const key_type key = keys[pos];
+        const size_t n = items.size();
+        while (true) {
+            const size_t first = pos * arity + 1;
+            if (first >= n) {
+                break;
+            }
+            const size_t last = first + arity < n ? first + arity : n;
+            size_t best = first;
+            for (size_t child = first + 1; child < last; child++) {
+                if (keys[child] < keys[best]) {
+                    best = child;
+                }
+            }
+            if (!(keys[best] < key)) {
+                break;
+            }
+            place(pos, items[best], keys[best]);
+            pos = best;
+        }
+        place(pos, item, key);
+    }
+};
+
+#endif //SHORTEST_PATHS_D_ARY_HEAP_H
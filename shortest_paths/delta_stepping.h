@@ -0,0 +1,236 @@
+// Delta-stepping (Meyer and Sanders) to find shortest paths in a directed weighted graph with nonnegative weights on
+// several threads. Nodes are kept in buckets of width delta by their tentative distance, and the nodes of the smallest
+// nonempty bucket are settled together: their light edges, of weight at most delta, are relaxed in phases until the
+// bucket stays empty, then the heavy edges of every node removed from it are relaxed once. A small delta approaches
+// Dijkstra's algorithm with little parallelism, a large one Bellman-Ford with a lot of repeated work.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_DELTA_STEPPING_H
+#define SHORTEST_PATHS_DELTA_STEPPING_H
+
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "digraph.h"
+
+namespace delta_stepping_detail
+{
+    template<typename node_id_type>
+    struct Request
+    {
+        node_id_type to;
+        node_id_type from;
+        double distance;
+    };
+
+    constexpr size_t no_bucket = std::numeric_limits<size_t>::max();
+
+    // Every thread owns the nodes congruent to its index modulo the number of threads, together with their buckets, and
+    // is the only one to read or write their distances and predecessors. Relaxing an edge sends a request to the owner
+    // of its head, which applies all requests after a barrier, so no atomics are needed. Only strict improvements are
+    // accepted, which keeps the predecessors a tree also with edges of weight zero.
+    template<IsDigraph graph_type>
+    class Engine
+    {
+    public:
+        using node_id_type = typename graph_type::node_id_type;
+
+        Engine(const graph_type & G, std::vector<double> & min_distances, std::vector<node_id_type> & predecessor, double delta,
+            unsigned num_threads)
+            : G(G), min_distances(min_distances), predecessor(predecessor), delta(delta), workers(num_threads),
+              queued_in(G.num_nodes(), no_bucket), settled(G.num_nodes(), 0), barrier(num_threads, Completion{this})
+        {
+            for (auto & worker : workers) {
+                worker.outbox.resize(num_threads);
+            }
+        }
+
+        void run(node_id_type measuring_from)
+        {
+            min_distances[measuring_from] = 0;
+            predecessor[measuring_from] = measuring_from;
+            insert(workers[owner(measuring_from)], measuring_from, 0);
+            std::vector<std::thread> threads;
+            for (unsigned t = 0; t < workers.size(); t++) {
+                threads.emplace_back([this, t] { work(t); });
+            }
+            for (auto & thread : threads) {
+                thread.join();
+            }
+        }
+
+    private:
+        struct Worker
+        {
+            std::vector<std::vector<node_id_type>> buckets;
+            std::vector<node_id_type> frontier;
+            // the nodes removed from the current bucket, whose heavy edges are relaxed once it stays empty
+            std::vector<node_id_type> removed;
+            // outbox[t] collects the requests for the nodes of thread t
+            std::vector<std::vector<Request<node_id_type>>> outbox;
+            bool current_nonempty = false;
+            size_t next_bucket = no_bucket;
+        };
+
+        // runs once per barrier phase, after every thread has arrived, and combines what the threads found
+        struct Completion
+        {
+            Engine * engine;
+
+            void operator()() noexcept
+            {
+                engine->any_in_current = false;
+                engine->next_bucket = no_bucket;
+                for (auto const & worker : engine->workers) {
+                    engine->any_in_current |= worker.current_nonempty;
+                    engine->next_bucket = std::min(engine->next_bucket, worker.next_bucket);
+                }
+            }
+        };
+
+        const graph_type & G;
+        std::vector<double> & min_distances;
+        std::vector<node_id_type> & predecessor;
+        const double delta;
+        std::vector<Worker> workers;
+        // the bucket a node is waiting in, so that it is never queued twice in one bucket and outdated entries are skipped
+        std::vector<size_t> queued_in;
+        // bytes rather than bits, since neighbouring nodes belong to different threads
+        std::vector<uint8_t> settled;
+        std::barrier<Completion> barrier;
+        bool any_in_current = false;
+        size_t next_bucket = no_bucket;
+
+        size_t owner(node_id_type node) const
+        {
+            return static_cast<size_t>(node) % workers.size();
+        }
+
+        void insert(Worker & worker, node_id_type node, double distance)
+        {
+            const size_t bucket = static_cast<size_t>(distance / delta);
+            if (queued_in[node] == bucket) {
+                return;
+            }
+            if (bucket >= worker.buckets.size()) {
+                worker.buckets.resize(bucket + 1);
+            }
+            worker.buckets[bucket].push_back(node);
+            queued_in[node] = bucket;
+        }
+
+        template<bool light>
+        void send(Worker & worker, node_id_type node)
+        {
+            const double distance = min_distances[node];
+            for (const auto & edge : G.adjList(node)) {
+                if ((edge.weight <= delta) == light) {
+                    worker.outbox[owner(edge.to)].push_back({edge.to, node, distance + edge.weight});
+                }
+            }
+        }
+
+        void apply_requests(unsigned t)
+        {
+            Worker & worker = workers[t];
+            for (auto & sender : workers) {
+                for (auto const & request : sender.outbox[t]) {
+                    if (request.distance < min_distances[request.to]) {
+                        min_distances[request.to] = request.distance;
+                        predecessor[request.to] = request.from;
+                        insert(worker, request.to, request.distance);
+                    }
+                }
+                sender.outbox[t].clear();
+            }
+        }
+
+        void work(unsigned t)
+        {
+            Worker & worker = workers[t];
+            // the index of the bucket being settled, the same in all threads
+            size_t current = 0;
+            while (true) {
+                // light phases: empty the current bucket until no request refills it
+                while (true) {
+                    worker.frontier.clear();
+                    if (current < worker.buckets.size()) {
+                        std::swap(worker.frontier, worker.buckets[current]);
+                    }
+                    for (node_id_type node : worker.frontier) {
+                        // entries of nodes that moved to a smaller bucket since are outdated
+                        if (queued_in[node] != current) {
+                            continue;
+                        }
+                        queued_in[node] = no_bucket;
+                        if (!settled[node]) {
+                            settled[node] = 1;
+                            worker.removed.push_back(node);
+                        }
+                        send<true>(worker, node);
+                    }
+                    barrier.arrive_and_wait();
+                    apply_requests(t);
+                    worker.current_nonempty = current < worker.buckets.size() && !worker.buckets[current].empty();
+                    barrier.arrive_and_wait();
+                    if (!any_in_current) {
+                        break;
+                    }
+                }
+
+                // heavy edges lead into later buckets, so relaxing them once with the final distances suffices
+                for (node_id_type node : worker.removed) {
+                    send<false>(worker, node);
+                    settled[node] = 0;
+                }
+                worker.removed.clear();
+                barrier.arrive_and_wait();
+                apply_requests(t);
+                worker.current_nonempty = false;
+                worker.next_bucket = no_bucket;
+                // heavy edges cannot refill the current bucket, but a rounded distance / delta might
+                for (size_t bucket = current; bucket < worker.buckets.size(); bucket++) {
+                    if (!worker.buckets[bucket].empty()) {
+                        worker.next_bucket = bucket;
+                        break;
+                    }
+                }
+                barrier.arrive_and_wait();
+                if (next_bucket == no_bucket) {
+                    break;
+                }
+                // every thread reads next_bucket before the completion of the next phase changes it
+                current = next_bucket;
+            }
+        }
+    };
+}
+
+// delta = 0 chooses the largest weight divided by the average outdegree, num_threads = 0 one thread per core.
+// min_distances has to hold std::numeric_limits<double>::max() for every node, unreachable nodes keep that value,
+// and predecessor is filled as by dijkstra. The buckets are indexed by distance / delta, so delta must not be tiny
+// compared to the largest distance.
+template<IsDigraph graph_type>
+void delta_stepping(const graph_type & G, std::vector<double> & min_distances, const typename graph_type::node_id_type measuring_from,
+    std::vector<typename graph_type::node_id_type> & predecessor, double delta = 0, unsigned num_threads = 0)
+{
+    if (delta <= 0) {
+        const double max_weight = G.num_edges() > 0 ? static_cast<double>(G.get_max()) : 0;
+        delta = max_weight * G.num_nodes() / std::max<double>(G.num_edges(), 1);
+        if (delta <= 0) {
+            delta = 1;
+        }
+    }
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    delta_stepping_detail::Engine<graph_type> engine(G, min_distances, predecessor, delta, num_threads);
+    engine.run(measuring_from);
+}
+
+#endif //SHORTEST_PATHS_DELTA_STEPPING_H
@@ -1,62 +1,37 @@
-// Dijkstra's algorithm to find shortest paths in a directed weighted graph with nonnegative weights.
+// Finds shortest paths with Dijkstra's algorithm, see shortest_paths/dijkstra.h, and prints them.
 // Author: Georgi Kocharyan
 
 #include <iostream>
 #include <limits>
-#include <ostream>
-#include <queue>
+#include <vector>
 
 #include "digraph.h"
+#include "graph_io/binary_graph.h"
+#include "graph_io/edge_list_reader.h"
+#include "shortest_paths/dijkstra.h"
+#include "shortest_paths/shortest_path_tree.h"
 
 using WeightedDigraph = Digraph<WeightedEdge<double>>;
 using Edge_w = WeightedEdge<double>;
 
-struct Vertex_with_predecessor
+int main(int argc, char * argv[])
 {
-    int node_id;
-    double distance;
-    int predecessor_id;
-
-    Vertex_with_predecessor(const int node, const double dist, const int pred_id) : node_id(node), distance(dist), predecessor_id(pred_id) {}
-    // smallest weight should have highest priority
-    bool operator<(Vertex_with_predecessor const & other) const {
-        return distance > other.distance;
-    }
-};
+    constexpr int measuring_from = 0;
 
-void dijkstra(const WeightedDigraph & G, std::vector<double> & min_distances, const int measuring_from, std::vector<int> & predecessor)
-{
-    // initialise the priority queue
-    min_distances[measuring_from] = 0;
-    std::vector<bool> fixed(G.num_nodes(), false);
-    std::priority_queue<Vertex_with_predecessor> pq;
-    for (int i = 0; i < G.num_nodes(); ++i) {
-        pq.emplace(i, min_distances[i], i);
-    }
-    // remove the root node
-    // loop through the priority queue and update weights appropriately
-    while (!pq.empty()) {
-        const Vertex_with_predecessor v = pq.top();
-        pq.pop();
-        // if this vertex has already been popped once or is inaccessible, ignore
-        if (fixed[v.node_id] || v.distance == std::numeric_limits<double>::max()) {
-            continue;
-        }
-        // its weight is the minimum distance from the root node
-        min_distances[v.node_id] = v.distance;
-        predecessor[v.node_id] = v.predecessor_id;
-        fixed[v.node_id] = true;
-        // loop through all neighbours of v and add them in if their min distance hasn't been determined yet
-        for (auto edge : (G.adjList(v.node_id))) {
-            if (!fixed[edge.to]) {
-                pq.emplace(edge.to, min_distances[v.node_id]+edge.weight, v.node_id);
-            }
-        }
+    // a graph can be given on the command line, either as a file written by write_binary_graph, which is mapped instead
+    // of parsed, or as text in one of the formats of graph_io/edge_list_reader.h, where "-" reads standard input:
+    //   dijsktra graph.bin
+    //   dijsktra dimacs road.gr
+    if (argc > 1) {
+        const CSRDigraph<Edge_w> G = argc > 2 ? to_csr(read_edge_list<double>(argv[2], parse_graph_format(argv[1])))
+                                              : map_binary_graph<Edge_w>(argv[1]);
+        std::vector<double> min_distances(G.num_nodes(), std::numeric_limits<double>::max());
+        std::vector<int> predecessor(G.num_nodes(), measuring_from);
+        dijkstra(G, min_distances, measuring_from, predecessor);
+        write_shortest_paths(std::cout, ShortestPathTree(measuring_from, predecessor, min_distances), min_distances);
+        return 0;
     }
-}
 
-int main()
-{
     constexpr int size = 8;
     WeightedDigraph G(size);
     G.add_edge(3,4,2);
@@ -74,31 +49,11 @@ int main()
     G.add_edge(4,2,1);
 
     std::vector<double> min_distances(size, std::numeric_limits<double>::max());
-    constexpr int measuring_from = 0;
     std::vector<int> predecessor(size, measuring_from);
 
     dijkstra(G, min_distances, measuring_from, predecessor);
 
-    // output isn't done very efficiently but in principle could be done better ( O(n^2+m) runtime applies to method dijkstra )
-
-    std::cout << measuring_from << " is the root node." << std::endl;
-    for (int i = 0; i < G.num_nodes(); ++i) {
-        if (i == measuring_from) {
-            continue;
-        }
-        std::cout << i;
-        if (min_distances[i] == std::numeric_limits<double>::max()) {
-            std::cout << " is inaccessible from " << measuring_from << "." << std::endl;
-        }
-        else {
-            int pred = predecessor[i];
-            while (pred != measuring_from) {
-                std::cout << " - " << pred;
-                pred = predecessor[pred];
-            }
-            std::cout << " - " << measuring_from << " is the shortest path with total weight " << min_distances[i] << "." << std::endl;
-        }
-    }
+    write_shortest_paths(std::cout, ShortestPathTree(measuring_from, predecessor, min_distances), min_distances);
 
     return 0;
 }
@@ -0,0 +1,41 @@
+// Dijkstra's algorithm to find shortest paths in a directed weighted graph with nonnegative weights.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_DIJKSTRA_H
+#define SHORTEST_PATHS_DIJKSTRA_H
+
+#include <limits>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/d_ary_heap.h"
+
+// min_distances has to hold std::numeric_limits<double>::max() for every node, unreachable nodes keep that value.
+// The heap holds every reached but not yet fixed node once, and a node is only pushed or moved up when its tentative
+// distance really improves, so the heap never grows beyond n and there are no stale entries to skip.
+// arity is the number of children per node of the heap, see shortest_paths/d_ary_heap.h.
+template<unsigned arity = 4, IsDigraph graph_type>
+void dijkstra(const graph_type & G, std::vector<double> & min_distances, const typename graph_type::node_id_type measuring_from,
+    std::vector<typename graph_type::node_id_type> & predecessor)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    min_distances[measuring_from] = 0;
+    predecessor[measuring_from] = measuring_from;
+    IndexedDAryHeap<double, node_id_type, arity> heap(G.num_nodes());
+    heap.push(measuring_from, 0);
+    while (!heap.empty()) {
+        // the tentative distance of the popped node is its minimum distance from the root node
+        const auto [node_id, distance] = heap.pop();
+        // with nonnegative weights no candidate can improve a fixed node, so they need no separate check
+        for (const auto & edge : G.adjList(node_id)) {
+            const double candidate = distance + edge.weight;
+            if (candidate < min_distances[edge.to]) {
+                min_distances[edge.to] = candidate;
+                predecessor[edge.to] = node_id;
+                heap.push_or_decrease(edge.to, candidate);
+            }
+        }
+    }
+}
+
+#endif //SHORTEST_PATHS_DIJKSTRA_H
@@ -0,0 +1,70 @@
+// Chooses the priority queue for Dijkstra's algorithm from the weights of the graph: Dial's buckets for integral weights
+// of small range, the radix heap for other integral weights, and the indexed d-ary heap for floating point weights.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_DIJKSTRA_AUTO_H
+#define SHORTEST_PATHS_DIJKSTRA_AUTO_H
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/dijkstra.h"
+#include "shortest_paths/dijkstra_dial.h"
+#include "shortest_paths/dijkstra_radix.h"
+
+enum class DijkstraQueue
+{
+    d_ary_heap,
+    radix_heap,
+    dial_buckets
+};
+
+// Dial sweeps the C + 1 buckets for the largest weight C, while the radix heap pays log C per node, so Dial is
+// chosen while the bucket array is no larger than about n + m.
+template<IsDigraph graph_type>
+DijkstraQueue select_dijkstra_queue(const graph_type & G)
+{
+    using weight_type = typename graph_type::weight_type;
+    if constexpr (!std::integral<weight_type>) {
+        return DijkstraQueue::d_ary_heap;
+    }
+    else {
+        if (G.num_edges() == 0 || G.get_max() <= 0) {
+            return DijkstraQueue::dial_buckets;
+        }
+        const size_t num_buckets = static_cast<size_t>(static_cast<std::make_unsigned_t<weight_type>>(G.get_max())) + 1;
+        const size_t dial_limit = std::max<size_t>(G.num_nodes() + G.num_edges(), 1024);
+        return num_buckets <= dial_limit ? DijkstraQueue::dial_buckets : DijkstraQueue::radix_heap;
+    }
+}
+
+// Runs Dijkstra's algorithm with the queue chosen by select_dijkstra_queue and returns that choice. Integral weights need
+// integral distances and floating point weights distances of type double, min_distances and predecessor are as for
+// dijkstra.
+template<IsDigraph graph_type, typename distance_type>
+DijkstraQueue dijkstra_auto(const graph_type & G, std::vector<distance_type> & min_distances, const typename graph_type::node_id_type measuring_from,
+    std::vector<typename graph_type::node_id_type> & predecessor)
+{
+    using weight_type = typename graph_type::weight_type;
+    const DijkstraQueue queue = select_dijkstra_queue(G);
+    if constexpr (std::integral<weight_type>) {
+        static_assert(std::integral<distance_type>, "integral weights need integral distances");
+        if (queue == DijkstraQueue::dial_buckets) {
+            dijkstra_dial(G, min_distances, measuring_from, predecessor);
+        }
+        else {
+            dijkstra_radix(G, min_distances, measuring_from, predecessor);
+        }
+    }
+    else {
+        static_assert(std::same_as<distance_type, double>, "floating point weights need distances of type double");
+        dijkstra(G, min_distances, measuring_from, predecessor);
+    }
+    return queue;
+}
+
+#endif //SHORTEST_PATHS_DIJKSTRA_AUTO_H
@@ -0,0 +1,109 @@
+// Dijkstra's algorithm with Dial's bucket queue, for nonnegative integral weights of small range. With C the largest
+// weight every tentative distance in the queue lies between the distance d of the node popped last and d + C, so C + 1
+// buckets used circularly, bucket i holding the nodes of tentative distance congruent to i, suffice. Every queue
+// operation takes constant time and the buckets are swept once up to the largest distance D, 64 at a time through a
+// bitmap of the occupied ones, which gives O(m + n + D / 64).
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_DIJKSTRA_DIAL_H
+#define SHORTEST_PATHS_DIJKSTRA_DIAL_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "digraph.h"
+
+// min_distances has to hold std::numeric_limits<distance_type>::max() for every node, unreachable nodes keep that value.
+// The buckets are doubly linked lists threaded through two arrays indexed by node, so a node whose distance improves is
+// moved to its new bucket instead of being pushed again, and no outdated entries have to be skipped. G.get_max() has to
+// be at least every weight, the buckets take G.get_max() + 1 node ids and as many bits of memory.
+template<IsDigraph graph_type, std::integral distance_type>
+void dijkstra_dial(const graph_type & G, std::vector<distance_type> & min_distances, const typename graph_type::node_id_type measuring_from,
+    std::vector<typename graph_type::node_id_type> & predecessor)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    constexpr node_id_type none = std::numeric_limits<node_id_type>::max();
+    constexpr distance_type unreachable = std::numeric_limits<distance_type>::max();
+    // a graph without edges reports the lowest weight as its maximum
+    const size_t num_buckets = G.num_edges() > 0 ? static_cast<size_t>(std::max<decltype(G.get_max())>(G.get_max(), 0)) + 1 : 1;
+    std::vector<node_id_type> first(num_buckets, none);
+    std::vector<node_id_type> next(G.num_nodes());
+    std::vector<node_id_type> previous(G.num_nodes());
+    // bit i % 64 of word i / 64 is set if bucket i holds a node
+    std::vector<uint64_t> occupied((num_buckets + 63) / 64, 0);
+
+    auto insert = [&](node_id_type node_id, size_t bucket) {
+        next[node_id] = first[bucket];
+        previous[node_id] = none;
+        if (first[bucket] != none) {
+            previous[first[bucket]] = node_id;
+        }
+        first[bucket] = node_id;
+        occupied[bucket / 64] |= uint64_t{1} << (bucket % 64);
+    };
+    auto remove = [&](node_id_type node_id, size_t bucket) {
+        if (previous[node_id] != none) {
+            next[previous[node_id]] = next[node_id];
+        }
+        else {
+            first[bucket] = next[node_id];
+            if (first[bucket] == none) {
+                occupied[bucket / 64] &= ~(uint64_t{1} << (bucket % 64));
+            }
+        }
+        if (next[node_id] != none) {
+            previous[next[node_id]] = previous[node_id];
+        }
+    };
+    // the bucket offset places after the current one, offset <= C
+    auto ahead = [&](size_t current, size_t offset) {
+        const size_t bucket = current + offset;
+        return bucket < num_buckets ? bucket : bucket - num_buckets;
+    };
+
+    min_distances[measuring_from] = 0;
+    predecessor[measuring_from] = measuring_from;
+    insert(measuring_from, 0);
+    size_t queued = 1;
+    size_t current = 0;
+    distance_type distance = 0;
+    while (queued > 0) {
+        if (first[current] == none) {
+            // the first occupied bucket circularly after current, found a word of the bitmap at a time
+            size_t word = current / 64;
+            uint64_t bits = occupied[word] & (~uint64_t{0} << (current % 64));
+            while (bits == 0) {
+                word = word + 1 < occupied.size() ? word + 1 : 0;
+                bits = occupied[word];
+            }
+            const size_t bucket = word * 64 + std::countr_zero(bits);
+            distance += static_cast<distance_type>(bucket >= current ? bucket - current : bucket + num_buckets - current);
+            current = bucket;
+        }
+        // the popped node has the smallest tentative distance, which is its minimum distance from the root node
+        const node_id_type node_id = first[current];
+        remove(node_id, current);
+        queued--;
+        for (const auto & edge : G.adjList(node_id)) {
+            const distance_type candidate = distance + edge.weight;
+            if (candidate < min_distances[edge.to]) {
+                if (min_distances[edge.to] == unreachable) {
+                    queued++;
+                }
+                else {
+                    remove(edge.to, ahead(current, static_cast<size_t>(min_distances[edge.to] - distance)));
+                }
+                min_distances[edge.to] = candidate;
+                predecessor[edge.to] = node_id;
+                insert(edge.to, ahead(current, static_cast<size_t>(edge.weight)));
+            }
+        }
+    }
+}
+
+#endif //SHORTEST_PATHS_DIJKSTRA_DIAL_H
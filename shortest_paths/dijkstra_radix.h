@@ -0,0 +1,47 @@
+// Dijkstra's algorithm to find shortest paths in a directed weighted graph with nonnegative integral weights,
+// implemented with the radix heap of shortest_paths/radix_heap.h.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_DIJKSTRA_RADIX_H
+#define SHORTEST_PATHS_DIJKSTRA_RADIX_H
+
+#include <concepts>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/radix_heap.h"
+
+// min_distances has to hold std::numeric_limits<distance_type>::max() for every node, unreachable nodes keep that value.
+// The radix heap has no decrease-key, so a node is pushed again on every improvement and outdated entries, whose key
+// is larger than the distance recorded since, are skipped when popped.
+template<IsDigraph graph_type, std::integral distance_type>
+void dijkstra_radix(const graph_type & G, std::vector<distance_type> & min_distances, const typename graph_type::node_id_type measuring_from,
+    std::vector<typename graph_type::node_id_type> & predecessor)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    using key_type = std::conditional_t<sizeof(distance_type) <= 4, uint32_t, uint64_t>;
+    min_distances[measuring_from] = 0;
+    predecessor[measuring_from] = measuring_from;
+    RadixHeap<key_type, node_id_type> heap;
+    heap.push(0, measuring_from);
+    while (!heap.empty()) {
+        const auto [key, node_id] = heap.pop();
+        const distance_type distance = static_cast<distance_type>(key);
+        if (distance > min_distances[node_id]) {
+            continue;
+        }
+        // its distance is the minimum distance from the root node
+        for (const auto & edge : G.adjList(node_id)) {
+            const distance_type candidate = distance + edge.weight;
+            if (candidate < min_distances[edge.to]) {
+                min_distances[edge.to] = candidate;
+                predecessor[edge.to] = node_id;
+                heap.push(static_cast<key_type>(candidate), edge.to);
+            }
+        }
+    }
+}
+
+#endif //SHORTEST_PATHS_DIJKSTRA_RADIX_H
@@ -0,0 +1,54 @@
+// Dense matrix of distances from a set of sources to every node, stored node by node in cache line aligned rows, as
+// computed by the multi-source searches and by Floyd-Warshall.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_DISTANCE_MATRIX_H
+#define SHORTEST_PATHS_DISTANCE_MATRIX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "shortest_paths/edge_arrays.h"
+
+// distances from num_sources sources to num_nodes nodes, node by node. Each row is padded to whole cache lines, and to
+// at least eight entries, so that every row starts aligned and the vector kernels need no scalar remainder.
+// Unreachable entries, and the padding, hold the maximum of distance_type.
+template<typename distance_type>
+struct DistanceMatrix
+{
+    // the entries of a row are a multiple of this
+    static constexpr size_t row_multiple = std::max<size_t>(8, 64 / sizeof(distance_type));
+
+    size_t num_nodes = 0;
+    size_t num_sources = 0;
+    size_t stride = 0;
+    std::vector<distance_type, AlignedAllocator<distance_type>> values;
+
+    DistanceMatrix() = default;
+
+    DistanceMatrix(size_t num_nodes, size_t num_sources)
+        : num_nodes(num_nodes), num_sources(num_sources), stride((num_sources + row_multiple - 1) / row_multiple * row_multiple),
+          values(num_nodes * stride, std::numeric_limits<distance_type>::max())
+    {
+    }
+
+    // the distance from the source-th source to node
+    distance_type operator()(size_t node, size_t source) const
+    {
+        return values[node * stride + source];
+    }
+
+    distance_type * row(size_t node)
+    {
+        return values.data() + node * stride;
+    }
+
+    distance_type const * row(size_t node) const
+    {
+        return values.data() + node * stride;
+    }
+};
+
+#endif //SHORTEST_PATHS_DISTANCE_MATRIX_H
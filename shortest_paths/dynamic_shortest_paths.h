@@ -0,0 +1,193 @@
+// Shortest paths from one node that are kept up to date while edge weights change, for nonnegative weights, after
+// Ramalingam and Reps. A batch of changes is applied to the graph, the subtrees of the shortest path tree below the edges
+// that became heavier are cleared and searched again from their unaffected in-neighbours, and the nodes that got closer
+// through an edge that became lighter are propagated from, all in one Dijkstra search that only visits the nodes whose
+// distances or predecessors may change and their edges, never the whole graph.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_DYNAMIC_SHORTEST_PATHS_H
+#define SHORTEST_PATHS_DYNAMIC_SHORTEST_PATHS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/d_ary_heap.h"
+#include "shortest_paths/dijkstra.h"
+
+template<typename weight_type, typename node_id_type>
+struct WeightChange
+{
+    node_id_type from;
+    node_id_type to;
+    weight_type weight; // the new weight of the edges from from to to
+};
+
+// Holds the distances and a shortest path tree of G from one node and repairs them on update. G is referenced, not
+// copied, and must only be changed through update as long as this is used. The repair needs the in-edges of G, so the
+// constructors build the in-edge index of a Digraph, in O(n + m), if it does not exist yet.
+template<HasInEdges graph_type>
+    requires requires (graph_type g, typename graph_type::node_id_type node_id, typename graph_type::weight_type weight) { g.set_weight(node_id, node_id, weight); }
+class DynamicShortestPaths
+{
+public:
+    using node_id_type = typename graph_type::node_id_type;
+    using weight_type = typename graph_type::weight_type;
+    using change_type = WeightChange<weight_type, node_id_type>;
+
+    // the predecessor of unreachable nodes
+    static constexpr node_id_type none = std::numeric_limits<node_id_type>::max();
+
+    // runs dijkstra from measuring_from
+    DynamicShortestPaths(graph_type & G, node_id_type measuring_from)
+        : DynamicShortestPaths(G, measuring_from, std::vector<double>(G.num_nodes(), std::numeric_limits<double>::max()),
+            std::vector<node_id_type>(G.num_nodes(), none))
+    {
+        dijkstra(G, min_distances, measuring_from, predecessor);
+    }
+
+    // takes over min_distances and predecessor as left by an earlier dijkstra run from measuring_from on G
+    DynamicShortestPaths(graph_type & G, node_id_type measuring_from, std::vector<double> min_distances, std::vector<node_id_type> predecessor)
+        : G(G), root(measuring_from), min_distances(std::move(min_distances)), predecessor(std::move(predecessor)), affected(G.num_nodes(), 0),
+          heap(G.num_nodes())
+    {
+        G.index_in_edges();
+        this->predecessor[root] = root;
+        for (size_t v = 0; v < G.num_nodes(); v++) {
+            if (this->min_distances[v] == std::numeric_limits<double>::max()) {
+                this->predecessor[v] = none;
+            }
+        }
+    }
+
+    // distances()[v] is the distance from the root to v, or the maximum of double if v cannot be reached
+    std::vector<double> const & distances() const
+    {
+        return min_distances;
+    }
+
+    // predecessors()[v] is the node before v on a shortest path from the root, the root itself for the root as dijkstra
+    // leaves it, and none for unreachable nodes
+    std::vector<node_id_type> const & predecessors() const
+    {
+        return predecessor;
+    }
+
+    // Sets the weights of the changed edges in G and repairs the distances and the tree. Returns the number of nodes
+    // whose distances were computed again, which bounds the work done together with their out- and in-edges.
+    size_t update(std::span<const change_type> changes);
+
+private:
+    // marks node_id and every node below it in the tree as affected
+    void mark_subtree(node_id_type node_id);
+
+    graph_type & G;
+    node_id_type root;
+    std::vector<double> min_distances;
+    std::vector<node_id_type> predecessor;
+    // affected[v] is set while v's old distance may be too small, only during update
+    std::vector<uint8_t> affected;
+    std::vector<node_id_type> subtree;
+    IndexedDAryHeap<double, node_id_type> heap;
+};
+
+template<HasInEdges graph_type>
+    requires requires (graph_type g, typename graph_type::node_id_type node_id, typename graph_type::weight_type weight) { g.set_weight(node_id, node_id, weight); }
+void DynamicShortestPaths<graph_type>::mark_subtree(node_id_type node_id)
+{
+    if (affected[node_id]) {
+        return;
+    }
+    affected[node_id] = 1;
+    const size_t start = subtree.size();
+    subtree.push_back(node_id);
+    for (size_t i = start; i < subtree.size(); i++) {
+        const node_id_type parent = subtree[i];
+        for (const auto & edge : G.adjList(parent)) {
+            if (!affected[edge.to] && predecessor[edge.to] == parent) {
+                affected[edge.to] = 1;
+                subtree.push_back(edge.to);
+            }
+        }
+    }
+}
+
+template<HasInEdges graph_type>
+    requires requires (graph_type g, typename graph_type::node_id_type node_id, typename graph_type::weight_type weight) { g.set_weight(node_id, node_id, weight); }
+size_t DynamicShortestPaths<graph_type>::update(std::span<const change_type> changes)
+{
+    constexpr double unreachable = std::numeric_limits<double>::max();
+    // the changes that made an edge lighter, to be relaxed once the affected nodes are known
+    std::vector<change_type> lighter;
+    subtree.clear();
+    for (const auto & change : changes) {
+        // with parallel edges the lightest one is the one shortest paths can use
+        const weight_type old_weight = G.set_weight(change.from, change.to, change.weight);
+        if (old_weight == std::numeric_limits<weight_type>::max() || change.weight == old_weight) {
+            continue;
+        }
+        if (change.weight < old_weight) {
+            lighter.push_back(change);
+        }
+        else if (change.to != root && predecessor[change.to] == change.from) {
+            // the distances below a tree edge that became heavier can only grow
+            mark_subtree(change.to);
+        }
+    }
+
+    // an affected node starts from the best of its in-edges from unaffected nodes, whose distances are still valid
+    for (const node_id_type v : subtree) {
+        min_distances[v] = unreachable;
+        predecessor[v] = none;
+    }
+    for (const node_id_type v : subtree) {
+        for (const auto & edge : G.inAdjList(v)) {
+            if (!affected[edge.from] && min_distances[edge.from] != unreachable && min_distances[edge.from] + edge.weight < min_distances[v]) {
+                min_distances[v] = min_distances[edge.from] + edge.weight;
+                predecessor[v] = edge.from;
+            }
+        }
+        if (min_distances[v] != unreachable) {
+            heap.push(v, min_distances[v]);
+        }
+    }
+    for (const node_id_type v : subtree) {
+        affected[v] = 0;
+    }
+    // the tail of a lighter edge that is in the heap relaxes the edge when it is popped. A later change of the batch may
+    // have made the edge heavier again, so one that would shorten a path is relaxed with the weights it has now.
+    for (const auto & change : lighter) {
+        const double from = min_distances[change.from];
+        if (from == unreachable || heap.contains(change.from) || from + change.weight >= min_distances[change.to]) {
+            continue;
+        }
+        for (const auto & edge : G.adjList(change.from)) {
+            if (edge.to == change.to && from + edge.weight < min_distances[change.to]) {
+                min_distances[change.to] = from + edge.weight;
+                predecessor[change.to] = change.from;
+                heap.push_or_decrease(change.to, min_distances[change.to]);
+            }
+        }
+    }
+
+    size_t recomputed = 0;
+    while (!heap.empty()) {
+        const auto [node_id, distance] = heap.pop();
+        recomputed++;
+        for (const auto & edge : G.adjList(node_id)) {
+            const double candidate = distance + edge.weight;
+            if (candidate < min_distances[edge.to]) {
+                min_distances[edge.to] = candidate;
+                predecessor[edge.to] = node_id;
+                heap.push_or_decrease(edge.to, candidate);
+            }
+        }
+    }
+    return recomputed;
+}
+
+#endif //SHORTEST_PATHS_DYNAMIC_SHORTEST_PATHS_H
@@ -0,0 +1,188 @@
+// Struct-of-arrays edge list and vectorised relaxation kernels for algorithms that sweep over all edges at once,
+// such as Moore-Bellman-Ford or the dynamic program in Karp's algorithm.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_EDGE_ARRAYS_H
+#define SHORTEST_PATHS_EDGE_ARRAYS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define EDGE_ARRAYS_X86_DISPATCH 1
+#endif
+
+#include "digraph.h"
+
+// allocator handing out cache line aligned memory, so that vector loads never straddle a line at the start
+template<typename T, size_t alignment = 64>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template<typename U>
+    AlignedAllocator(AlignedAllocator<U, alignment> const &) {}
+
+    T * allocate(size_t n)
+    {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+    }
+
+    void deallocate(T * p, size_t)
+    {
+        ::operator delete(p, std::align_val_t(alignment));
+    }
+
+    template<typename U>
+    bool operator==(AlignedAllocator<U, alignment> const &) const
+    {
+        return true;
+    }
+};
+
+// all edges of a graph, with sources, targets and weights in separate arrays.
+// the edges are stored node by node in the order of adjList, so sweeps visit them in the same order as the graph.
+template<typename weight_type, typename node_id_type = int>
+struct EdgeArrays
+{
+    std::vector<node_id_type, AlignedAllocator<node_id_type>> sources;
+    std::vector<node_id_type, AlignedAllocator<node_id_type>> targets;
+    std::vector<weight_type, AlignedAllocator<weight_type>> weights;
+
+    EdgeArrays() = default;
+
+    template<IsDigraph graph_type>
+    explicit EdgeArrays(graph_type const & G)
+    {
+        sources.reserve(G.num_edges());
+        targets.reserve(G.num_edges());
+        weights.reserve(G.num_edges());
+        for (node_id_type i = 0; i < G.num_nodes(); i++) {
+            for (auto const & edge : G.adjList(i)) {
+                sources.push_back(edge.from);
+                targets.push_back(edge.to);
+                weights.push_back(edge.weight);
+            }
+        }
+    }
+
+    size_t size() const
+    {
+        return targets.size();
+    }
+};
+
+namespace edge_arrays_detail
+{
+    template<typename weight_type, typename node_id_type>
+    bool relax_scalar(EdgeArrays<weight_type, node_id_type> const & E, size_t first, weight_type const * in, weight_type * out)
+    {
+        bool changed = false;
+        for (size_t e = first; e < E.size(); e++) {
+            const weight_type candidate = in[E.sources[e]] + E.weights[e];
+            if (candidate < out[E.targets[e]]) {
+                out[E.targets[e]] = candidate;
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+#ifdef EDGE_ARRAYS_X86_DISPATCH
+    // candidates are computed for a whole vector of edges at once. Only the lanes that improve are written back,
+    // one by one, so that several edges into the same node within a vector keep the smallest candidate.
+    __attribute__((target("avx2")))
+    inline size_t relax_avx2(EdgeArrays<double> const & E, double const * in, double * out, bool & changed)
+    {
+        const size_t vector_end = E.size() / 4 * 4;
+        // masked gathers with a zero pass-through: the unmasked ones start from an undefined register, which GCC warns about
+        const __m256d all_lanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        for (size_t e = 0; e < vector_end; e += 4) {
+            const __m128i sources = _mm_load_si128(reinterpret_cast<const __m128i *>(E.sources.data() + e));
+            const __m128i targets = _mm_load_si128(reinterpret_cast<const __m128i *>(E.targets.data() + e));
+            const __m256d candidates = _mm256_add_pd(_mm256_mask_i32gather_pd(_mm256_setzero_pd(), in, sources, all_lanes, 8), _mm256_load_pd(E.weights.data() + e));
+            const __m256d current = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), out, targets, all_lanes, 8);
+            int improving = _mm256_movemask_pd(_mm256_cmp_pd(candidates, current, _CMP_LT_OQ));
+            if (improving == 0) {
+                continue;
+            }
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, candidates);
+            for (; improving != 0; improving &= improving - 1) {
+                const int lane = __builtin_ctz(improving);
+                double & target = out[E.targets[e + lane]];
+                if (lanes[lane] < target) {
+                    target = lanes[lane];
+                    changed = true;
+                }
+            }
+        }
+        return vector_end;
+    }
+
+    __attribute__((target("avx512f")))
+    inline size_t relax_avx512(EdgeArrays<double> const & E, double const * in, double * out, bool & changed)
+    {
+        const size_t vector_end = E.size() / 8 * 8;
+        for (size_t e = 0; e < vector_end; e += 8) {
+            const __m256i sources = _mm256_load_si256(reinterpret_cast<const __m256i *>(E.sources.data() + e));
+            const __m256i targets = _mm256_load_si256(reinterpret_cast<const __m256i *>(E.targets.data() + e));
+            const __m512d candidates = _mm512_add_pd(_mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, sources, in, 8), _mm512_load_pd(E.weights.data() + e));
+            const __m512d current = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xff, targets, out, 8);
+            unsigned improving = _mm512_cmp_pd_mask(candidates, current, _CMP_LT_OQ);
+            if (improving == 0) {
+                continue;
+            }
+            alignas(64) double lanes[8];
+            _mm512_store_pd(lanes, candidates);
+            for (; improving != 0; improving &= improving - 1) {
+                const int lane = __builtin_ctz(improving);
+                double & target = out[E.targets[e + lane]];
+                if (lanes[lane] < target) {
+                    target = lanes[lane];
+                    changed = true;
+                }
+            }
+        }
+        return vector_end;
+    }
+#endif
+}
+
+// relaxes every edge once: out[to] = min(out[to], in[from] + weight). in and out may be the same array, as in
+// Moore-Bellman-Ford, or two different rows, as in Karp's recursion. Returns whether any entry of out decreased.
+// double weights with 32 bit node ids use AVX-512 or AVX2 if the processor has them, everything else runs the scalar loop.
+template<typename weight_type, typename node_id_type>
+bool relax_all_edges(EdgeArrays<weight_type, node_id_type> const & E, weight_type const * in, weight_type * out)
+{
+#ifdef EDGE_ARRAYS_X86_DISPATCH
+    if constexpr (std::is_same_v<weight_type, double> && std::is_same_v<node_id_type, int>) {
+        static const bool has_avx512 = __builtin_cpu_supports("avx512f");
+        static const bool has_avx2 = __builtin_cpu_supports("avx2");
+        bool changed = false;
+        size_t done = 0;
+        if (has_avx512) {
+            done = edge_arrays_detail::relax_avx512(E, in, out, changed);
+        }
+        else if (has_avx2) {
+            done = edge_arrays_detail::relax_avx2(E, in, out, changed);
+        }
+        return edge_arrays_detail::relax_scalar(E, done, in, out) || changed;
+    }
+#endif
+    return edge_arrays_detail::relax_scalar(E, 0, in, out);
+}
+
+#endif //SHORTEST_PATHS_EDGE_ARRAYS_H
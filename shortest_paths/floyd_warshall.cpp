@@ -2,43 +2,14 @@
 // Need the weights to be conservative, i.e. no negative weight cycle to exist.
 // Author: Georgi Kocharyan
 
-#include <algorithm>
 #include <iostream>
 #include <limits>
-#include <ostream>
+#include <sstream>
 
 #include "digraph.h"
+#include "shortest_paths/floyd_warshall.h"
 
 using WeightedDigraph = Digraph<WeightedEdge<double>>;
-using Edge_w = WeightedEdge<double>;
-
-
-void floyd_warshall (const WeightedDigraph & G, std::vector<std::vector<double>> & min_distances)
-{
-    for (int i = 0; i < G.num_nodes(); i++) {
-        min_distances[i][i] = 0;
-    }
-    for (int i = 0; i < G.num_nodes(); i++) {
-        for (const auto & edge : G.adjList(i)) {
-            min_distances[edge.to][edge.from] = edge.weight;
-        }
-    }
-    // d_i,j(0) is now initialised. Now run through the recursion n times.
-    std::vector<std::vector<double>> temp(G.num_nodes(), std::vector<double>(G.num_nodes()));
-    for (int k = 0; k < G.num_nodes(); k++) {
-        for (int i = 0; i < G.num_nodes(); i++) {
-            for (int j = 0; j < G.num_nodes(); j++) {
-                temp[i][j] = std::min(min_distances[i][j], min_distances[i][k] + min_distances[k][j]);
-            }
-        }
-        // set the k-th iteration of min_distances to temp
-        for (int i = 0; i < G.num_nodes(); i++) {
-            for (int j = 0; j < G.num_nodes(); j++) {
-                min_distances[i][j] = temp[i][j];
-            }
-        }
-    }
-}
 
 int main()
 {
@@ -57,26 +28,26 @@ int main()
     G.add_edge(4,6,3);
     G.add_edge(0,7,0.5);
     G.add_edge(4,2,1);
-    // initialise all min distances to infinity
-
-    std::vector<std::vector<double>> min_distances(size, std::vector<double>(size, std::numeric_limits<double>::max()));
 
-    floyd_warshall(G, min_distances);
+    NextHopMatrix next_hop;
+    const DistanceMatrix<double> min_distances = floyd_warshall(G, next_hop);
 
-    // output the distances
-
-        for (int i = 0; i < G.num_nodes(); ++i) {
-            for (int j = 0; j < G.num_nodes(); ++j) {
-                if (min_distances[i][j] == std::numeric_limits<double>::max()) {
-                    std::cout << "There is no path from " << i << " to " << j << " ." << std::endl;
-                }
-                else {
-                    std::cout << i << " has distance " << min_distances[i][j] << " from " << j << "." << std::endl;
-                }
+    // output the distances and the paths, collected first and written in one go
+    std::ostringstream text;
+    for (int i = 0; i < G.num_nodes(); ++i) {
+        for (int j = 0; j < G.num_nodes(); ++j) {
+            if (min_distances(i, j) == std::numeric_limits<double>::max()) {
+                text << "There is no path from " << j << " to " << i << ".\n";
+                continue;
             }
-
+            text << i << " has distance " << min_distances(i, j) << " from " << j << ", along";
+            for (const int node : next_hop.path(j, i)) {
+                text << ' ' << node;
+            }
+            text << ".\n";
         }
+    }
+    std::cout << text.str() << std::flush;
 
     return 0;
-
-}
\ No newline at end of file
+}
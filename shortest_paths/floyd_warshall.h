@@ -0,0 +1,510 @@
+// The Floyd-Warshall algorithm for all pairs of distances in weighted digraphs. The weights need to be conservative,
+// i.e. no negative weight cycle may exist. The matrix is updated in place, tile by tile in the three phases of the
+// blocked algorithm, with vectorised min-plus kernels, and the independent tiles of a phase run on several threads.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_FLOYD_WARSHALL_H
+#define SHORTEST_PATHS_FLOYD_WARSHALL_H
+
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/distance_matrix.h"
+#include "shortest_paths/edge_arrays.h"
+
+// The first steps of the shortest paths between all pairs of nodes, laid out as the DistanceMatrix they come with: entry
+// (i, j) is the node after j on a shortest path from j to i, i itself if i == j, and -1 if i cannot be reached from j.
+// Node ids have to fit into 32 bits, which any graph whose n x n matrix fits into memory does.
+struct NextHopMatrix
+{
+    size_t num_nodes = 0;
+    size_t stride = 0;
+    std::vector<int32_t, AlignedAllocator<int32_t>> values;
+
+    NextHopMatrix() = default;
+
+    NextHopMatrix(size_t num_nodes, size_t stride) : num_nodes(num_nodes), stride(stride), values(num_nodes * stride, -1)
+    {
+    }
+
+    // the node after source on a shortest path from source to node
+    int32_t operator()(size_t node, size_t source) const
+    {
+        return values[node * stride + source];
+    }
+
+    int32_t * row(size_t node)
+    {
+        return values.data() + node * stride;
+    }
+
+    // The nodes of a shortest path from `from` to `to`, both included, or none if there is no path, in time linear in
+    // its length. A path of zero weight cycles may be followed around forever, so there must be none.
+    std::vector<int32_t> path(size_t from, size_t to) const
+    {
+        std::vector<int32_t> nodes;
+        if ((*this)(to, from) < 0) {
+            return nodes;
+        }
+        nodes.push_back(static_cast<int32_t>(from));
+        for (size_t v = from; v != to; v = (*this)(to, v)) {
+            nodes.push_back((*this)(to, v));
+        }
+        return nodes;
+    }
+};
+
+namespace floyd_warshall_detail
+{
+    // side of the square tiles. Three tiles of doubles take 96 KiB and stay in the L2 cache.
+    constexpr size_t tile = 64;
+
+    // c[j] = min(c[j], a + b[j]) for j < cols, where b[j] may be unreachable. a is never unreachable. With floating
+    // point distances an unreachable b[j] gives a + b[j] >= c[j] by itself, integers have to skip it to not overflow.
+    template<typename distance_type>
+    inline void relax_row_scalar(distance_type * c, distance_type a, distance_type const * b, size_t cols)
+    {
+        for (size_t j = 0; j < cols; j++) {
+            if constexpr (std::is_integral_v<distance_type>) {
+                if (b[j] == std::numeric_limits<distance_type>::max()) {
+                    continue;
+                }
+            }
+            c[j] = std::min(c[j], static_cast<distance_type>(a + b[j]));
+        }
+    }
+
+    // c[i][j] = min(c[i][j], a[i][k] + b[k][j]) on a tile c of rows x cols entries, where a has depth columns and b
+    // depth rows, by relax_row(i * stride, a[i][k], k * stride), which relaxes the row of c at the first offset with the
+    // row of b at the second. The diagonal tile of a phase is a, b and c at once, and needs k in the outer loop so that
+    // paths through several of its nodes are found. Everywhere else k may go in the middle, which keeps the row of c in
+    // the L1 cache.
+    template<typename distance_type, typename row_kernel>
+    __attribute__((always_inline))
+    inline void relax_tile(distance_type const * a, size_t rows, size_t depth, size_t stride, bool diagonal, row_kernel relax_row)
+    {
+        constexpr distance_type unreachable = std::numeric_limits<distance_type>::max();
+        if (diagonal) {
+            for (size_t k = 0; k < depth; k++) {
+                for (size_t i = 0; i < rows; i++) {
+                    if (a[i * stride + k] != unreachable) {
+                        relax_row(i * stride, a[i * stride + k], k * stride);
+                    }
+                }
+            }
+            return;
+        }
+        for (size_t i = 0; i < rows; i++) {
+            for (size_t k = 0; k < depth; k++) {
+                if (a[i * stride + k] != unreachable) {
+                    relax_row(i * stride, a[i * stride + k], k * stride);
+                }
+            }
+        }
+    }
+
+    // as relax_row_scalar, and where c[j] improves hop_c[j] becomes hop_b[j]
+    template<typename distance_type>
+    inline void relax_row_scalar(distance_type * c, int32_t * hop_c, distance_type a, distance_type const * b, int32_t const * hop_b, size_t cols)
+    {
+        for (size_t j = 0; j < cols; j++) {
+            if constexpr (std::is_integral_v<distance_type>) {
+                if (b[j] == std::numeric_limits<distance_type>::max()) {
+                    continue;
+                }
+            }
+            const distance_type candidate = a + b[j];
+            if (candidate < c[j]) {
+                c[j] = candidate;
+                hop_c[j] = hop_b[j];
+            }
+        }
+    }
+
+    template<typename distance_type>
+    void relax_tile_scalar(distance_type * c, distance_type const * a, distance_type const * b, size_t rows, size_t cols,
+        size_t depth, size_t stride, bool diagonal)
+    {
+        relax_tile(a, rows, depth, stride, diagonal, [=](size_t row_c, distance_type a_ik, size_t row_b) {
+            relax_row_scalar(c + row_c, a_ik, b + row_b, cols);
+        });
+    }
+
+    // hop_c and hop_b are the tiles of the next hop matrix at the places of c and b
+    template<typename distance_type>
+    void relax_hop_tile_scalar(distance_type * c, int32_t * hop_c, distance_type const * a, distance_type const * b, int32_t const * hop_b,
+        size_t rows, size_t cols, size_t depth, size_t stride, bool diagonal)
+    {
+        relax_tile(a, rows, depth, stride, diagonal, [=](size_t row_c, distance_type a_ik, size_t row_b) {
+            relax_row_scalar(c + row_c, hop_c + row_c, a_ik, b + row_b, hop_b + row_b, cols);
+        });
+    }
+
+#ifdef EDGE_ARRAYS_X86_DISPATCH
+    // the rows start on a cache line and cols is a multiple of the entries of one, so all loads are aligned and full
+    __attribute__((target("avx2")))
+    inline void relax_row_avx2(double * c, double a, double const * b, size_t cols)
+    {
+        const __m256d broadcast = _mm256_set1_pd(a);
+        for (size_t j = 0; j < cols; j += 4) {
+            _mm256_store_pd(c + j, _mm256_min_pd(_mm256_load_pd(c + j), _mm256_add_pd(broadcast, _mm256_load_pd(b + j))));
+        }
+    }
+
+    __attribute__((target("avx2")))
+    inline void relax_row_avx2(float * c, float a, float const * b, size_t cols)
+    {
+        const __m256 broadcast = _mm256_set1_ps(a);
+        for (size_t j = 0; j < cols; j += 8) {
+            _mm256_store_ps(c + j, _mm256_min_ps(_mm256_load_ps(c + j), _mm256_add_ps(broadcast, _mm256_load_ps(b + j))));
+        }
+    }
+
+    __attribute__((target("avx2")))
+    inline void relax_row_avx2(int32_t * c, int32_t a, int32_t const * b, size_t cols)
+    {
+        const __m256i broadcast = _mm256_set1_epi32(a);
+        const __m256i unreachable = _mm256_set1_epi32(std::numeric_limits<int32_t>::max());
+        for (size_t j = 0; j < cols; j += 8) {
+            const __m256i from = _mm256_load_si256(reinterpret_cast<const __m256i *>(b + j));
+            const __m256i candidates = _mm256_blendv_epi8(_mm256_add_epi32(broadcast, from), from, _mm256_cmpeq_epi32(from, unreachable));
+            __m256i * to = reinterpret_cast<__m256i *>(c + j);
+            _mm256_store_si256(to, _mm256_min_epi32(_mm256_load_si256(to), candidates));
+        }
+    }
+
+    // The next hops of the improved entries are blended in with the distances. They are 32 bit wide, so with double
+    // distances a vector of four hops goes with a vector of four distances, whose 64 bit comparison masks are narrowed.
+    __attribute__((target("avx2")))
+    inline void relax_row_avx2(double * c, int32_t * hop_c, double a, double const * b, int32_t const * hop_b, size_t cols)
+    {
+        const __m256d broadcast = _mm256_set1_pd(a);
+        const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+        for (size_t j = 0; j < cols; j += 4) {
+            const __m256d candidates = _mm256_add_pd(broadcast, _mm256_load_pd(b + j));
+            const __m256d current = _mm256_load_pd(c + j);
+            const __m256d better = _mm256_cmp_pd(candidates, current, _CMP_LT_OQ);
+            _mm256_store_pd(c + j, _mm256_blendv_pd(current, candidates, better));
+            const __m128i mask = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(better), low_halves));
+            __m128i * hops = reinterpret_cast<__m128i *>(hop_c + j);
+            _mm_store_si128(hops, _mm_blendv_epi8(_mm_load_si128(hops), _mm_load_si128(reinterpret_cast<const __m128i *>(hop_b + j)), mask));
+        }
+    }
+
+    __attribute__((target("avx2")))
+    inline void relax_row_avx2(float * c, int32_t * hop_c, float a, float const * b, int32_t const * hop_b, size_t cols)
+    {
+        const __m256 broadcast = _mm256_set1_ps(a);
+        for (size_t j = 0; j < cols; j += 8) {
+            const __m256 candidates = _mm256_add_ps(broadcast, _mm256_load_ps(b + j));
+            const __m256 current = _mm256_load_ps(c + j);
+            const __m256 better = _mm256_cmp_ps(candidates, current, _CMP_LT_OQ);
+            _mm256_store_ps(c + j, _mm256_blendv_ps(current, candidates, better));
+            __m256i * hops = reinterpret_cast<__m256i *>(hop_c + j);
+            _mm256_store_si256(hops, _mm256_blendv_epi8(_mm256_load_si256(hops), _mm256_load_si256(reinterpret_cast<const __m256i *>(hop_b + j)),
+                _mm256_castps_si256(better)));
+        }
+    }
+
+    __attribute__((target("avx2")))
+    inline void relax_row_avx2(int32_t * c, int32_t * hop_c, int32_t a, int32_t const * b, int32_t const * hop_b, size_t cols)
+    {
+        const __m256i broadcast = _mm256_set1_epi32(a);
+        const __m256i unreachable = _mm256_set1_epi32(std::numeric_limits<int32_t>::max());
+        for (size_t j = 0; j < cols; j += 8) {
+            const __m256i from = _mm256_load_si256(reinterpret_cast<const __m256i *>(b + j));
+            const __m256i candidates = _mm256_blendv_epi8(_mm256_add_epi32(broadcast, from), from, _mm256_cmpeq_epi32(from, unreachable));
+            __m256i * to = reinterpret_cast<__m256i *>(c + j);
+            const __m256i current = _mm256_load_si256(to);
+            const __m256i better = _mm256_cmpgt_epi32(current, candidates);
+            _mm256_store_si256(to, _mm256_blendv_epi8(current, candidates, better));
+            __m256i * hops = reinterpret_cast<__m256i *>(hop_c + j);
+            _mm256_store_si256(hops, _mm256_blendv_epi8(_mm256_load_si256(hops), _mm256_load_si256(reinterpret_cast<const __m256i *>(hop_b + j)), better));
+        }
+    }
+
+    template<typename distance_type>
+    __attribute__((target("avx2")))
+    void relax_tile_avx2(distance_type * c, distance_type const * a, distance_type const * b, size_t rows, size_t cols,
+        size_t depth, size_t stride, bool diagonal)
+    {
+        relax_tile(a, rows, depth, stride, diagonal, [=](size_t row_c, distance_type a_ik, size_t row_b) __attribute__((target("avx2"))) {
+            relax_row_avx2(c + row_c, a_ik, b + row_b, cols);
+        });
+    }
+
+    template<typename distance_type>
+    __attribute__((target("avx2")))
+    void relax_hop_tile_avx2(distance_type * c, int32_t * hop_c, distance_type const * a, distance_type const * b, int32_t const * hop_b,
+        size_t rows, size_t cols, size_t depth, size_t stride, bool diagonal)
+    {
+        relax_tile(a, rows, depth, stride, diagonal, [=](size_t row_c, distance_type a_ik, size_t row_b) __attribute__((target("avx2"))) {
+            relax_row_avx2(c + row_c, hop_c + row_c, a_ik, b + row_b, hop_b + row_b, cols);
+        });
+    }
+
+    // the minima are masked with all lanes set and a zero source: the unmasked forms pass an undefined register
+    // through, which GCC warns about
+    __attribute__((target("avx512f")))
+    inline void relax_row_avx512(double * c, double a, double const * b, size_t cols)
+    {
+        const __m512d broadcast = _mm512_set1_pd(a);
+        for (size_t j = 0; j < cols; j += 8) {
+            _mm512_store_pd(c + j, _mm512_mask_min_pd(_mm512_setzero_pd(), 0xff, _mm512_load_pd(c + j), _mm512_add_pd(broadcast, _mm512_load_pd(b + j))));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    inline void relax_row_avx512(float * c, float a, float const * b, size_t cols)
+    {
+        const __m512 broadcast = _mm512_set1_ps(a);
+        for (size_t j = 0; j < cols; j += 16) {
+            _mm512_store_ps(c + j, _mm512_mask_min_ps(_mm512_setzero_ps(), 0xffff, _mm512_load_ps(c + j), _mm512_add_ps(broadcast, _mm512_load_ps(b + j))));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    inline void relax_row_avx512(int32_t * c, int32_t a, int32_t const * b, size_t cols)
+    {
+        const __m512i broadcast = _mm512_set1_epi32(a);
+        const __m512i unreachable = _mm512_set1_epi32(std::numeric_limits<int32_t>::max());
+        for (size_t j = 0; j < cols; j += 16) {
+            const __m512i from = _mm512_load_si512(b + j);
+            const __m512i candidates = _mm512_mask_add_epi32(from, _mm512_cmpneq_epi32_mask(from, unreachable), broadcast, from);
+            _mm512_store_si512(c + j, _mm512_mask_min_epi32(_mm512_setzero_si512(), 0xffff, _mm512_load_si512(c + j), candidates));
+        }
+    }
+
+    // with double distances the eight hops of a vector take the lower half of a register, and the masked store leaves
+    // the upper half untouched
+    __attribute__((target("avx512f")))
+    inline void relax_row_avx512(double * c, int32_t * hop_c, double a, double const * b, int32_t const * hop_b, size_t cols)
+    {
+        const __m512d broadcast = _mm512_set1_pd(a);
+        for (size_t j = 0; j < cols; j += 8) {
+            const __m512d candidates = _mm512_add_pd(broadcast, _mm512_load_pd(b + j));
+            const __mmask8 better = _mm512_cmp_pd_mask(candidates, _mm512_load_pd(c + j), _CMP_LT_OQ);
+            _mm512_mask_store_pd(c + j, better, candidates);
+            const __m512i hops = _mm512_castsi256_si512(_mm256_load_si256(reinterpret_cast<const __m256i *>(hop_b + j)));
+            _mm512_mask_storeu_epi32(hop_c + j, better, hops);
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    inline void relax_row_avx512(float * c, int32_t * hop_c, float a, float const * b, int32_t const * hop_b, size_t cols)
+    {
+        const __m512 broadcast = _mm512_set1_ps(a);
+        for (size_t j = 0; j < cols; j += 16) {
+            const __m512 candidates = _mm512_add_ps(broadcast, _mm512_load_ps(b + j));
+            const __mmask16 better = _mm512_cmp_ps_mask(candidates, _mm512_load_ps(c + j), _CMP_LT_OQ);
+            _mm512_mask_store_ps(c + j, better, candidates);
+            _mm512_mask_store_epi32(hop_c + j, better, _mm512_load_si512(hop_b + j));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    inline void relax_row_avx512(int32_t * c, int32_t * hop_c, int32_t a, int32_t const * b, int32_t const * hop_b, size_t cols)
+    {
+        const __m512i broadcast = _mm512_set1_epi32(a);
+        const __m512i unreachable = _mm512_set1_epi32(std::numeric_limits<int32_t>::max());
+        for (size_t j = 0; j < cols; j += 16) {
+            const __m512i from = _mm512_load_si512(b + j);
+            const __m512i candidates = _mm512_mask_add_epi32(from, _mm512_cmpneq_epi32_mask(from, unreachable), broadcast, from);
+            const __mmask16 better = _mm512_cmplt_epi32_mask(candidates, _mm512_load_si512(c + j));
+            _mm512_mask_store_epi32(c + j, better, candidates);
+            _mm512_mask_store_epi32(hop_c + j, better, _mm512_load_si512(hop_b + j));
+        }
+    }
+
+    template<typename distance_type>
+    __attribute__((target("avx512f")))
+    void relax_tile_avx512(distance_type * c, distance_type const * a, distance_type const * b, size_t rows, size_t cols,
+        size_t depth, size_t stride, bool diagonal)
+    {
+        relax_tile(a, rows, depth, stride, diagonal, [=](size_t row_c, distance_type a_ik, size_t row_b) __attribute__((target("avx512f"))) {
+            relax_row_avx512(c + row_c, a_ik, b + row_b, cols);
+        });
+    }
+
+    template<typename distance_type>
+    __attribute__((target("avx512f")))
+    void relax_hop_tile_avx512(distance_type * c, int32_t * hop_c, distance_type const * a, distance_type const * b, int32_t const * hop_b,
+        size_t rows, size_t cols, size_t depth, size_t stride, bool diagonal)
+    {
+        relax_tile(a, rows, depth, stride, diagonal, [=](size_t row_c, distance_type a_ik, size_t row_b) __attribute__((target("avx512f"))) {
+            relax_row_avx512(c + row_c, hop_c + row_c, a_ik, b + row_b, hop_b + row_b, cols);
+        });
+    }
+#endif
+
+    template<typename distance_type>
+    using TileKernel = void (*)(distance_type *, distance_type const *, distance_type const *, size_t, size_t, size_t, size_t, bool);
+
+    // double, float and 32 bit integers use AVX-512 or AVX2 if the processor has them, everything else the scalar loop
+    template<typename distance_type>
+    TileKernel<distance_type> tile_kernel()
+    {
+#ifdef EDGE_ARRAYS_X86_DISPATCH
+        if constexpr (std::is_same_v<distance_type, double> || std::is_same_v<distance_type, float> || std::is_same_v<distance_type, int32_t>) {
+            if (__builtin_cpu_supports("avx512f")) {
+                return relax_tile_avx512<distance_type>;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return relax_tile_avx2<distance_type>;
+            }
+        }
+#endif
+        return relax_tile_scalar<distance_type>;
+    }
+
+    template<typename distance_type>
+    using HopTileKernel = void (*)(distance_type *, int32_t *, distance_type const *, distance_type const *, int32_t const *, size_t, size_t,
+        size_t, size_t, bool);
+
+    template<typename distance_type>
+    HopTileKernel<distance_type> hop_tile_kernel()
+    {
+#ifdef EDGE_ARRAYS_X86_DISPATCH
+        if constexpr (std::is_same_v<distance_type, double> || std::is_same_v<distance_type, float> || std::is_same_v<distance_type, int32_t>) {
+            if (__builtin_cpu_supports("avx512f")) {
+                return relax_hop_tile_avx512<distance_type>;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return relax_hop_tile_avx2<distance_type>;
+            }
+        }
+#endif
+        return relax_hop_tile_scalar<distance_type>;
+    }
+
+    // Runs the recursion of Floyd-Warshall on D for one block of tile values of k at a time. The diagonal tile of the
+    // block is closed first, then the other tiles of its row and column use it, and then all remaining tiles use those.
+    // The tiles of the last two phases are independent of each other and are spread over the threads. If next_hop is
+    // given, an entry of it changes to the one of row k with every entry of D that improves through k.
+    template<typename distance_type>
+    void close(DistanceMatrix<distance_type> & D, NextHopMatrix * next_hop, unsigned num_threads)
+    {
+        static const TileKernel<distance_type> relax_distances = tile_kernel<distance_type>();
+        static const HopTileKernel<distance_type> relax_hops = hop_tile_kernel<distance_type>();
+        const size_t n = D.num_nodes;
+        const size_t stride = D.stride;
+        const size_t blocks = (n + tile - 1) / tile;
+        distance_type * values = D.values.data();
+        // the nodes in a block, and the entries of its tiles' rows that the kernels relax, which include the padding
+        // of the last block
+        auto length = [&](size_t block) { return std::min(tile, n - block * tile); };
+        auto width = [&](size_t block) { return std::min(tile, stride - block * tile); };
+        auto at = [&](size_t row_block, size_t col_block) { return values + row_block * tile * stride + col_block * tile; };
+        auto hops_at = [&](size_t row_block, size_t col_block) { return next_hop->values.data() + row_block * tile * stride + col_block * tile; };
+        // relaxes tile (ib, jb) with tiles (ib, kb) and (kb, jb)
+        auto relax = [&](size_t ib, size_t jb, size_t kb, size_t rows, size_t cols, size_t depth, bool diagonal) {
+            if (next_hop) {
+                relax_hops(at(ib, jb), hops_at(ib, jb), at(ib, kb), at(kb, jb), hops_at(kb, jb), rows, cols, depth, stride, diagonal);
+            }
+            else {
+                relax_distances(at(ib, jb), at(ib, kb), at(kb, jb), rows, cols, depth, stride, diagonal);
+            }
+        };
+
+        num_threads = std::max<size_t>(1, std::min<size_t>(num_threads, blocks));
+        std::barrier sync(num_threads);
+        auto work = [&](unsigned t) {
+            for (size_t kb = 0; kb < blocks; kb++) {
+                const size_t depth = length(kb);
+                if (t == 0) {
+                    relax(kb, kb, kb, depth, width(kb), depth, true);
+                }
+                sync.arrive_and_wait();
+                for (size_t x = t; x < blocks; x += num_threads) {
+                    if (x != kb) {
+                        relax(kb, x, kb, depth, width(x), depth, false);
+                        relax(x, kb, kb, length(x), width(kb), depth, false);
+                    }
+                }
+                sync.arrive_and_wait();
+                for (size_t ib = t; ib < blocks; ib += num_threads) {
+                    for (size_t jb = 0; jb < blocks; jb++) {
+                        if (ib != kb && jb != kb) {
+                            relax(ib, jb, kb, length(ib), width(jb), depth, false);
+                        }
+                    }
+                }
+                sync.arrive_and_wait();
+            }
+        };
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < num_threads; t++) {
+            threads.emplace_back(work, t);
+        }
+        work(0);
+        for (auto & thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+namespace floyd_warshall_detail
+{
+    // the matrix of the weights of the edges, and of their heads as the next hops if next_hop is given, closed
+    template<typename distance_type, IsDigraph graph_type>
+    DistanceMatrix<distance_type> run(const graph_type & G, NextHopMatrix * next_hop, unsigned num_threads)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        static_assert(std::is_arithmetic_v<distance_type>);
+        if (num_threads == 0) {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        DistanceMatrix<distance_type> min_distances(G.num_nodes(), G.num_nodes());
+        if (next_hop) {
+            *next_hop = NextHopMatrix(G.num_nodes(), min_distances.stride);
+        }
+        for (node_id_type i = 0; i < G.num_nodes(); i++) {
+            min_distances.row(i)[i] = 0;
+            if (next_hop) {
+                next_hop->row(i)[i] = static_cast<int32_t>(i);
+            }
+        }
+        // of several parallel edges only the lightest counts
+        for (node_id_type i = 0; i < G.num_nodes(); i++) {
+            for (const auto & edge : G.adjList(i)) {
+                distance_type & entry = min_distances.row(edge.to)[edge.from];
+                if (static_cast<distance_type>(edge.weight) < entry) {
+                    entry = static_cast<distance_type>(edge.weight);
+                    if (next_hop) {
+                        next_hop->row(edge.to)[edge.from] = static_cast<int32_t>(edge.to);
+                    }
+                }
+            }
+        }
+        close(min_distances, next_hop, num_threads);
+        return min_distances;
+    }
+}
+
+// Distances between all pairs of nodes. Entry (i, j) of the result is the distance from j to i, or the maximum of
+// distance_type if i cannot be reached from j; a negative entry on the diagonal reveals a negative cycle. float or 32
+// bit integers halve the size of the matrix compared to double, then every distance has to fit into distance_type.
+// num_threads = 0 uses one thread per core.
+template<typename distance_type = double, IsDigraph graph_type>
+DistanceMatrix<distance_type> floyd_warshall(const graph_type & G, unsigned num_threads = 0)
+{
+    return floyd_warshall_detail::run<distance_type>(G, nullptr, num_threads);
+}
+
+// Also fills next_hop, which the kernels keep up to date along with the distances, so that every shortest path can be
+// read off it in time linear in its length. A path whose entry improves through k continues as the path to k does, so
+// the final next hops follow shortest paths as long as there is no cycle of weight at most zero.
+template<typename distance_type = double, IsDigraph graph_type>
+DistanceMatrix<distance_type> floyd_warshall(const graph_type & G, NextHopMatrix & next_hop, unsigned num_threads = 0)
+{
+    return floyd_warshall_detail::run<distance_type>(G, &next_hop, num_threads);
+}
+
+#endif //SHORTEST_PATHS_FLOYD_WARSHALL_H
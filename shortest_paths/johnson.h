@@ -0,0 +1,208 @@
+// Johnson's algorithm for all pairs of distances in sparse weighted digraphs with negative weights but without negative
+// cycles. Moore-Bellman-Ford with every distance starting at 0 computes potentials once, which make every reweighted
+// edge nonnegative, and then one Dijkstra search per node runs on the reweighted graph on several threads.
+// The distances are handed out row by row, so that the n x n matrix never has to be held in memory.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_JOHNSON_H
+#define SHORTEST_PATHS_JOHNSON_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "digraph.h"
+#include "graph_io/binary_graph.h"
+#include "shortest_paths/dijkstra.h"
+#include "shortest_paths/moore_bellman_ford.h"
+
+namespace johnson_detail
+{
+    // Potentials p with weight + p[from] - p[to] >= 0 for every edge, the distances from a virtual source with an edge
+    // of weight 0 to every node. Those are the distances Moore-Bellman-Ford finds when every node starts at distance 0,
+    // so the virtual source is never built. Returns false if G has a negative cycle.
+    template<IsDigraph graph_type>
+    bool potentials(const graph_type & G, std::vector<double> & potential)
+    {
+        potential.assign(G.num_nodes(), 0.0);
+        if (G.num_nodes() == 0) {
+            return true;
+        }
+        bool negative_cycle = false;
+        moore_bellman_ford(G, potential, 0, negative_cycle);
+        return !negative_cycle;
+    }
+
+    // G with every weight replaced by weight + p[from] - p[to]. Rounding may leave tiny negative values, which are
+    // raised to 0.
+    template<IsDigraph graph_type>
+    CSRDigraph<WeightedEdge<double, typename graph_type::node_id_type>> reweighted(const graph_type & G, std::vector<double> const & potential)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        std::vector<WeightedEdge<double, node_id_type>> edges;
+        edges.reserve(G.num_edges());
+        for (node_id_type v = 0; v < G.num_nodes(); v++) {
+            for (const auto & edge : G.adjList(v)) {
+                edges.emplace_back(edge.from, edge.to, std::max(0.0, edge.weight + potential[edge.from] - potential[edge.to]));
+            }
+        }
+        return CSRDigraph<WeightedEdge<double, node_id_type>>(G.num_nodes(), edges);
+    }
+}
+
+// Distances from every node to every node. row(source, distances) is called once per node, with distances[v] the
+// distance from source to v, or the maximum of double if v cannot be reached. The rows come in no particular order,
+// from the worker threads, but never two calls at the same time, so row needs no locking of its own. distances is only
+// valid during the call. An exception thrown by row stops the search and is rethrown.
+// Returns false, without calling row, if G has a negative cycle. num_threads = 0 uses one thread per core.
+template<IsDigraph graph_type, typename row_function>
+bool johnson(const graph_type & G, row_function && row, unsigned num_threads = 0)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    std::vector<double> potential;
+    if (!johnson_detail::potentials(G, potential)) {
+        return false;
+    }
+    const auto reweighted = johnson_detail::reweighted(G, potential);
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = std::max<size_t>(1, std::min<size_t>(num_threads, G.num_nodes()));
+
+    std::atomic<size_t> next{0};
+    std::mutex emitting;
+    std::exception_ptr failure;
+    auto work = [&] {
+        // every thread reuses its own buffers for all of its searches
+        std::vector<double> distances;
+        std::vector<node_id_type> predecessor(G.num_nodes());
+        for (size_t source = next++; source < G.num_nodes(); source = next++) {
+            distances.assign(G.num_nodes(), std::numeric_limits<double>::max());
+            dijkstra(reweighted, distances, static_cast<node_id_type>(source), predecessor);
+            // a path of reweighted length d has length d - p[source] + p[v] in G
+            for (size_t v = 0; v < distances.size(); v++) {
+                if (distances[v] != std::numeric_limits<double>::max()) {
+                    distances[v] += potential[v] - potential[source];
+                }
+            }
+            std::lock_guard<std::mutex> lock(emitting);
+            if (failure) {
+                return;
+            }
+            try {
+                row(static_cast<node_id_type>(source), static_cast<std::vector<double> const &>(distances));
+            }
+            catch (...) {
+                failure = std::current_exception();
+                next = G.num_nodes();
+                return;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < num_threads; t++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return true;
+}
+
+// Layout of a file, all values in native byte order:
+//   DistanceRowsFileHeader
+//   rows    (num_nodes rows of num_nodes doubles, row s holding the distances from s, unreachable nodes the maximum of double)
+constexpr char distance_rows_file_magic[8] = {'D', 'I', 'S', 'T', 'R', 'O', 'W', 'S'};
+constexpr uint32_t distance_rows_file_version = 1;
+
+struct DistanceRowsFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t value_code; // type of the distances, see binary_type_code
+    uint32_t reserved;
+    uint64_t num_nodes;
+};
+
+static_assert(sizeof(DistanceRowsFileHeader) == 32);
+
+// Runs johnson and writes the rows to path as they are computed, each to its place in the file. Returns false, and
+// leaves no file behind, if G has a negative cycle.
+template<IsDigraph graph_type>
+bool write_all_pairs_distances(const graph_type & G, std::string const & path, unsigned num_threads = 0)
+{
+    DistanceRowsFileHeader header{};
+    std::memcpy(header.magic, distance_rows_file_magic, sizeof(header.magic));
+    header.version = distance_rows_file_version;
+    header.byte_order = binary_graph_byte_order;
+    header.value_code = binary_type_code<double>();
+    header.num_nodes = G.num_nodes();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("cannot open " + path + " for writing");
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    const bool conservative = johnson(G, [&](size_t source, std::vector<double> const & distances) {
+        out.seekp(static_cast<std::streamoff>(sizeof(header) + source * distances.size() * sizeof(double)));
+        out.write(reinterpret_cast<const char *>(distances.data()), static_cast<std::streamsize>(distances.size() * sizeof(double)));
+        if (!out) {
+            throw std::runtime_error("error while writing " + path);
+        }
+    }, num_threads);
+    out.close();
+    if (!conservative) {
+        std::remove(path.c_str());
+    }
+    else if (!out) {
+        throw std::runtime_error("error while writing " + path);
+    }
+    return conservative;
+}
+
+// the distances from source to every node, as stored by write_all_pairs_distances
+inline std::vector<double> read_distance_row(std::string const & path, uint64_t source)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    DistanceRowsFileHeader header{};
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, distance_rows_file_magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error(path + " is not a distance rows file");
+    }
+    if (header.version == 0 || header.version > distance_rows_file_version) {
+        throw std::runtime_error(path + " has unsupported format version " + std::to_string(header.version));
+    }
+    if (header.byte_order != binary_graph_byte_order || header.value_code != binary_type_code<double>()) {
+        throw std::runtime_error(path + " was written on an incompatible platform");
+    }
+    if (source >= header.num_nodes) {
+        throw std::invalid_argument("node " + std::to_string(source) + " is not in " + path);
+    }
+    std::vector<double> distances(header.num_nodes);
+    in.seekg(static_cast<std::streamoff>(sizeof(header) + source * header.num_nodes * sizeof(double)));
+    in.read(reinterpret_cast<char *>(distances.data()), static_cast<std::streamsize>(distances.size() * sizeof(double)));
+    if (!in) {
+        throw std::runtime_error(path + " is truncated");
+    }
+    return distances;
+}
+
+#endif //SHORTEST_PATHS_JOHNSON_H
@@ -1,6 +1,5 @@
-// Implementation of the Moore-Bellman-Ford algorithm for finding minimum distances in weighted digraphs.
-// Need the weights to be conservative, i.e. no negative weight cycle to exist.
-// outputs the existence of a negative cycle, in case one exists.
+// Finds minimum distances with the Moore-Bellman-Ford algorithm, see shortest_paths/moore_bellman_ford.h, and prints
+// them, or the existence of a negative cycle, in case one exists.
 // Author: Georgi Kocharyan
 
 #include <iostream>
@@ -8,29 +7,9 @@
 #include <ostream>
 
 #include "digraph.h"
+#include "shortest_paths/moore_bellman_ford.h"
 
 using WeightedDigraph = Digraph<WeightedEdge<double>>;
-using Edge_w = WeightedEdge<double>;
-
-void moore_bellman_ford(const WeightedDigraph & G, std::vector<double> & min_distances, const int measuring_from, bool & negative_cycle)
-{
-    min_distances[measuring_from] = 0;
-    for (int i = 1; i < G.num_nodes(); i++) {
-        for (int node_id = 0; node_id < G.num_nodes(); node_id++) {
-            for (const auto & edge : G.adjList(node_id)) {
-                min_distances[edge.to] = std::min(min_distances[edge.to], min_distances[edge.from] + edge.weight);
-            }
-        }
-    }
-    // if there is no negative cycle, we have correctly determined the min_distances. Repeating the loop once will reveal the existence of one if the min_distances change.
-    for (int node_id = 0; node_id < G.num_nodes(); node_id++) {
-        for (const auto & edge : G.adjList(node_id)) {
-            if (min_distances[edge.to] > min_distances[edge.from] + edge.weight) {
-                negative_cycle = true;
-            }
-        }
-    }
-}
 
 int main()
 {
@@ -0,0 +1,127 @@
+// The Moore-Bellman-Ford algorithm for finding minimum distances in weighted digraphs.
+// Need the weights to be conservative, i.e. no negative weight cycle to exist.
+// reports the existence of a negative cycle, in case one exists. The rounds end early once one of them changes nothing.
+// spfa is the queue driven variant, which returns the cycle itself.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_MOORE_BELLMAN_FORD_H
+#define SHORTEST_PATHS_MOORE_BELLMAN_FORD_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/edge_arrays.h"
+
+template<IsDigraph graph_type>
+void moore_bellman_ford(const graph_type & G, std::vector<double> & min_distances, const typename graph_type::node_id_type measuring_from, bool & negative_cycle)
+{
+    // the rounds sweep over all edges at once, which the struct-of-arrays layout lets us vectorise
+    const EdgeArrays<double, typename graph_type::node_id_type> edges(G);
+    min_distances[measuring_from] = 0;
+    for (size_t i = 1; i < G.num_nodes(); i++) {
+        // a round without any change leaves every later one without change as well
+        if (!relax_all_edges(edges, min_distances.data(), min_distances.data())) {
+            return;
+        }
+    }
+    // if there is no negative cycle, we have correctly determined the min_distances. Repeating the loop once will reveal the existence of one if the min_distances change.
+    if (relax_all_edges(edges, min_distances.data(), min_distances.data())) {
+        negative_cycle = true;
+    }
+}
+
+// The queue driven variant of Moore-Bellman-Ford, also known as the shortest path faster algorithm: only the edges out of
+// nodes whose distance decreased are relaxed again, and the search ends as soon as the queue runs empty.
+// Negative cycles are found with Tarjan's subtree disassembly. The shortest path tree is kept in preorder in a circular
+// list together with the depths of the nodes. When the distance of a node v decreases, its subtree is cut out of the tree
+// and its descendants are not scanned until they are reached again, as their distances are outdated. If the node whose
+// edge improved v lies in that subtree, the tree path from v to it closes a negative cycle with that edge.
+// min_distances has to hold std::numeric_limits<double>::max() for every node. Returns the nodes of a negative cycle
+// reachable from measuring_from in the order of its edges, or nothing if there is none, in which case min_distances
+// and predecessor hold the shortest paths and unreachable nodes keep their distance.
+template<IsDigraph graph_type>
+std::vector<typename graph_type::node_id_type> spfa(const graph_type & G, std::vector<double> & min_distances,
+    const typename graph_type::node_id_type measuring_from, std::vector<typename graph_type::node_id_type> & predecessor)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    const size_t n = G.num_nodes();
+    // the neighbours of every node of the tree in preorder
+    std::vector<node_id_type> before(n);
+    std::vector<node_id_type> after(n);
+    std::vector<size_t> depth(n, 0);
+    std::vector<uint8_t> in_tree(n, 0);
+    std::vector<uint8_t> queued(n, 0);
+    // every node is queued at most once at a time, so a ring of n entries suffices
+    std::vector<node_id_type> queue(n);
+    size_t head = 0;
+    size_t queue_size = 0;
+
+    min_distances[measuring_from] = 0;
+    predecessor[measuring_from] = measuring_from;
+    before[measuring_from] = measuring_from;
+    after[measuring_from] = measuring_from;
+    in_tree[measuring_from] = 1;
+    queue[0] = measuring_from;
+    queued[measuring_from] = 1;
+    queue_size = 1;
+
+    while (queue_size > 0) {
+        const node_id_type u = queue[head];
+        head = head + 1 == n ? 0 : head + 1;
+        queue_size--;
+        queued[u] = 0;
+        // u was cut out of the tree after it was queued, and is queued again once it is reached again
+        if (!in_tree[u]) {
+            continue;
+        }
+        for (const auto & edge : G.adjList(u)) {
+            const node_id_type v = edge.to;
+            const double candidate = min_distances[u] + edge.weight;
+            if (!(candidate < min_distances[v])) {
+                continue;
+            }
+            if (v == u) {
+                return {u};
+            }
+            if (in_tree[v]) {
+                // cut out v together with its subtree, which follows v in preorder with larger depths
+                node_id_type x = after[v];
+                while (depth[x] > depth[v]) {
+                    if (x == u) {
+                        std::vector<node_id_type> cycle;
+                        for (node_id_type y = u; y != v; y = predecessor[y]) {
+                            cycle.push_back(y);
+                        }
+                        cycle.push_back(v);
+                        std::reverse(cycle.begin(), cycle.end());
+                        return cycle;
+                    }
+                    in_tree[x] = 0;
+                    x = after[x];
+                }
+                after[before[v]] = x;
+                before[x] = before[v];
+            }
+            min_distances[v] = candidate;
+            predecessor[v] = u;
+            // v becomes the first child of u
+            depth[v] = depth[u] + 1;
+            in_tree[v] = 1;
+            before[v] = u;
+            after[v] = after[u];
+            before[after[u]] = v;
+            after[u] = v;
+            if (!queued[v]) {
+                queue[(head + queue_size) % n] = v;
+                queue_size++;
+                queued[v] = 1;
+            }
+        }
+    }
+    return {};
+}
+
+#endif //SHORTEST_PATHS_MOORE_BELLMAN_FORD_H
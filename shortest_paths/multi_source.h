@@ -0,0 +1,238 @@
+// Shortest path distances from several sources at once. Every node carries one distance per source, and scanning a node
+// relaxes each of its edges for the sources together with vectorised min-plus operations, so the graph is traversed
+// once for the whole batch instead of once per source. Unweighted graphs use a bit-parallel breadth first search.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_MULTI_SOURCE_H
+#define SHORTEST_PATHS_MULTI_SOURCE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/d_ary_heap.h"
+#include "shortest_paths/distance_matrix.h"
+#include "shortest_paths/edge_arrays.h"
+
+namespace multi_source_detail
+{
+    // The kernels relax one edge for the sources whose distance at its tail decreased since the tail was last scanned.
+    // The sources come in blocks of eight, and marked[b] has bit i set if source 8b + i decreased at the tail. They set
+    // to[j] = min(to[j], from[j] + weight) for the marked sources, mark the sources that decreased in changed, and return
+    // the smallest distance that decreased, or the maximum of double if none did.
+    inline double min_plus_scalar(double const * from, uint8_t const * marked, double weight, double * to, uint8_t * changed, size_t blocks)
+    {
+        double smallest = std::numeric_limits<double>::max();
+        for (size_t b = 0; b < blocks; b++) {
+            for (unsigned lanes = marked[b]; lanes != 0; lanes &= lanes - 1) {
+                const size_t i = 8 * b + std::countr_zero(lanes);
+                const double candidate = from[i] + weight;
+                if (candidate < to[i]) {
+                    to[i] = candidate;
+                    changed[b] |= uint8_t(1) << (i - 8 * b);
+                    smallest = std::min(smallest, candidate);
+                }
+            }
+        }
+        return smallest;
+    }
+
+#ifdef EDGE_ARRAYS_X86_DISPATCH
+    __attribute__((target("avx2")))
+    inline double min_plus_avx2(double const * from, uint8_t const * marked, double weight, double * to, uint8_t * changed, size_t blocks)
+    {
+        const __m256d infinity = _mm256_set1_pd(std::numeric_limits<double>::max());
+        const __m256d weights = _mm256_set1_pd(weight);
+        // the lanes of a half block whose bit is set in a mask
+        const __m256i bits = _mm256_set_epi64x(8, 4, 2, 1);
+        __m256d smallest = infinity;
+        for (size_t b = 0; b < blocks; b++) {
+            if (marked[b] == 0) {
+                continue;
+            }
+            for (unsigned half = 0; half < 2; half++) {
+                const unsigned lanes = (marked[b] >> (4 * half)) & 15;
+                if (lanes == 0) {
+                    continue;
+                }
+                const size_t i = 8 * b + 4 * half;
+                const __m256d selected = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(lanes), bits), bits));
+                const __m256d candidates = _mm256_add_pd(_mm256_load_pd(from + i), weights);
+                const __m256d current = _mm256_load_pd(to + i);
+                const __m256d improving = _mm256_and_pd(selected, _mm256_cmp_pd(candidates, current, _CMP_LT_OQ));
+                const int improved = _mm256_movemask_pd(improving);
+                if (improved != 0) {
+                    _mm256_store_pd(to + i, _mm256_blendv_pd(current, candidates, improving));
+                    smallest = _mm256_min_pd(smallest, _mm256_blendv_pd(infinity, candidates, improving));
+                    changed[b] |= uint8_t(improved << (4 * half));
+                }
+            }
+        }
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, smallest);
+        return std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+    }
+
+    __attribute__((target("avx512f")))
+    inline double min_plus_avx512(double const * from, uint8_t const * marked, double weight, double * to, uint8_t * changed, size_t blocks)
+    {
+        const __m512d weights = _mm512_set1_pd(weight);
+        __m512d smallest = _mm512_set1_pd(std::numeric_limits<double>::max());
+        for (size_t b = 0; b < blocks; b++) {
+            if (marked[b] == 0) {
+                continue;
+            }
+            const __m512d candidates = _mm512_add_pd(_mm512_load_pd(from + 8 * b), weights);
+            const __mmask8 improving = _mm512_mask_cmp_pd_mask(marked[b], candidates, _mm512_load_pd(to + 8 * b), _CMP_LT_OQ);
+            if (improving != 0) {
+                _mm512_mask_store_pd(to + 8 * b, improving, candidates);
+                smallest = _mm512_mask_min_pd(smallest, improving, smallest, candidates);
+                changed[b] |= improving;
+            }
+        }
+        // reduced through memory, _mm512_reduce_min_pd passes an undefined register through that GCC warns about
+        alignas(64) double lanes[8];
+        _mm512_store_pd(lanes, smallest);
+        return *std::min_element(lanes, lanes + 8);
+    }
+#endif
+
+    using MinPlusKernel = double (*)(double const *, uint8_t const *, double, double *, uint8_t *, size_t);
+
+    inline MinPlusKernel min_plus_kernel()
+    {
+#ifdef EDGE_ARRAYS_X86_DISPATCH
+        if (__builtin_cpu_supports("avx512f")) {
+            return min_plus_avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return min_plus_avx2;
+        }
+#endif
+        return min_plus_scalar;
+    }
+}
+
+// Distances from every node of sources to every node, with nonnegative weights. The nodes wait in a heap keyed by the
+// smallest of their distances that decreased since they were last scanned, so the batch advances roughly like one
+// Dijkstra search per source. A scan relaxes the edges of a node only for the sources whose distance decreased, and a
+// node is scanned again whenever a later relaxation decreases another of its distances. Where the searches of the
+// sources overlap, one scan serves several of them at once.
+template<IsDigraph graph_type>
+DistanceMatrix<double> multi_source_shortest_paths(const graph_type & G, std::span<const typename graph_type::node_id_type> sources)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    static const multi_source_detail::MinPlusKernel min_plus = multi_source_detail::min_plus_kernel();
+    DistanceMatrix<double> distances(G.num_nodes(), sources.size());
+    const size_t blocks = distances.stride / 8;
+    // the sources whose distance decreased since the last scan, one bit per source
+    std::vector<uint8_t> marked(G.num_nodes() * blocks);
+    std::vector<uint8_t> scanning(blocks);
+    IndexedDAryHeap<double, node_id_type> heap(G.num_nodes());
+    for (size_t i = 0; i < sources.size(); i++) {
+        distances.row(sources[i])[i] = 0;
+        marked[sources[i] * blocks + i / 8] |= uint8_t(1) << (i % 8);
+        heap.push_or_decrease(sources[i], 0);
+    }
+    while (!heap.empty()) {
+        const node_id_type node = heap.pop().first;
+        // a self loop may mark the node again while it is scanned
+        uint8_t * node_marked = marked.data() + node * blocks;
+        std::copy(node_marked, node_marked + blocks, scanning.begin());
+        std::fill(node_marked, node_marked + blocks, 0);
+        const double * from = distances.row(node);
+        for (const auto & edge : G.adjList(node)) {
+            const double smallest = min_plus(from, scanning.data(), static_cast<double>(edge.weight), distances.row(edge.to),
+                marked.data() + edge.to * blocks, blocks);
+            if (smallest != std::numeric_limits<double>::max()) {
+                heap.push_or_decrease(edge.to, smallest);
+            }
+        }
+    }
+    return distances;
+}
+
+// Breadth first search from up to 64 sources at once, each source one bit of a word per node: a level ORs the frontier
+// bits of every active node into its neighbours, and the bits a node has not seen before put it on the next frontier.
+// More sources are handled in batches of 64. Distances count edges, weights are ignored.
+template<IsDigraph graph_type>
+DistanceMatrix<int> multi_source_bfs(const graph_type & G, std::span<const typename graph_type::node_id_type> sources)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    // the sources that have reached a node, reached it on the current level, and reach it on the next level. They are
+    // kept together since a relaxation reads and writes all three of the same node.
+    struct Bits
+    {
+        uint64_t seen = 0;
+        uint64_t frontier = 0;
+        uint64_t next = 0;
+    };
+    const size_t n = G.num_nodes();
+    DistanceMatrix<int> distances(n, sources.size());
+    std::vector<Bits> bits(n);
+    std::vector<node_id_type> active;
+    std::vector<node_id_type> next_active;
+    for (size_t first = 0; first < sources.size(); first += 64) {
+        const size_t batch = std::min<size_t>(64, sources.size() - first);
+        std::fill(bits.begin(), bits.end(), Bits{});
+        active.clear();
+        for (size_t i = 0; i < batch; i++) {
+            const node_id_type source = sources[first + i];
+            if (bits[source].frontier == 0) {
+                active.push_back(source);
+            }
+            bits[source].frontier |= uint64_t{1} << i;
+            bits[source].seen |= uint64_t{1} << i;
+            distances.row(source)[first + i] = 0;
+        }
+        for (int level = 1; !active.empty(); level++) {
+            next_active.clear();
+            for (node_id_type node : active) {
+                const uint64_t frontier = bits[node].frontier;
+                bits[node].frontier = 0;
+                for (const auto & edge : G.adjList(node)) {
+                    Bits & target = bits[edge.to];
+                    const uint64_t discovered = frontier & ~target.seen;
+                    if (discovered != 0) {
+                        if (target.next == 0) {
+                            next_active.push_back(edge.to);
+                        }
+                        target.next |= discovered;
+                    }
+                }
+            }
+            for (node_id_type node : next_active) {
+                Bits & current = bits[node];
+                current.frontier = current.next;
+                current.next = 0;
+                current.seen |= current.frontier;
+                int * row = distances.row(node) + first;
+                for (uint64_t reached = current.frontier; reached != 0; reached &= reached - 1) {
+                    row[std::countr_zero(reached)] = level;
+                }
+            }
+            std::swap(active, next_active);
+        }
+    }
+    return distances;
+}
+
+// bit-parallel breadth first search for graphs without weights, the min-plus batch otherwise
+template<IsDigraph graph_type>
+auto multi_source_distances(const graph_type & G, std::span<const typename graph_type::node_id_type> sources)
+{
+    if constexpr (IsWeighted<std::remove_cvref_t<decltype(*G.adjList(0).begin())>>) {
+        return multi_source_shortest_paths(G, sources);
+    }
+    else {
+        return multi_source_bfs(G, sources);
+    }
+}
+
+#endif //SHORTEST_PATHS_MULTI_SOURCE_H
@@ -0,0 +1,157 @@
+// Moore-Bellman-Ford on several threads for graphs with negative weights. Every thread relaxes its own contiguous part of
+// the edge list, lowering distances with lock-free atomic minimum updates, and the threads meet only at the end of
+// every round to decide whether another one is needed. The edges out of nodes whose distance did not change since they
+// were last relaxed are skipped. Need the weights to be conservative, i.e. no negative weight cycle to exist, and
+// reports the existence of one, in case one exists, as moore_bellman_ford does.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_PARALLEL_BELLMAN_FORD_H
+#define SHORTEST_PATHS_PARALLEL_BELLMAN_FORD_H
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/edge_arrays.h"
+
+namespace parallel_bellman_ford_detail
+{
+    // lowers target to candidate unless it already holds a value at most as large, returns whether it did
+    inline bool atomic_min(double & target, double candidate)
+    {
+        std::atomic_ref<double> value(target);
+        double current = value.load(std::memory_order_relaxed);
+        while (candidate < current) {
+            if (value.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Relaxes the edges in rounds until one changes nothing, or until n rounds were needed, which reveals a negative
+    // cycle. Every thread owns a contiguous range of nodes with about the same number of out-edges, and relaxes the
+    // out-edges of those of its nodes that are marked as lowered since their edges were last relaxed. Within a round the
+    // threads see each other's updates as they happen, as the sequential sweep does, so the number of rounds may vary
+    // from run to run, but the distances it ends with do not. Returns whether there is a negative cycle.
+    template<IsDigraph graph_type>
+    bool relax_rounds(const graph_type & G, std::vector<double> & min_distances, unsigned num_threads)
+    {
+        using node_id_type = typename graph_type::node_id_type;
+        constexpr double unreachable = std::numeric_limits<double>::max();
+        const size_t n = G.num_nodes();
+        // the out-edges of node v are edges offsets[v] to offsets[v + 1] - 1 of E
+        const EdgeArrays<double, node_id_type> E(G);
+        std::vector<size_t> offsets(n + 1, 0);
+        for (size_t v = 0; v < n; v++) {
+            offsets[v + 1] = offsets[v] + G.outdeg(v);
+        }
+        std::vector<uint8_t> lowered(n, 0);
+        for (size_t v = 0; v < n; v++) {
+            lowered[v] = min_distances[v] != unreachable;
+        }
+
+        num_threads = std::max<size_t>(1, std::min<size_t>(num_threads, n));
+        std::vector<size_t> first_node(num_threads + 1, n);
+        for (unsigned t = 0; t < num_threads; t++) {
+            first_node[t] = std::lower_bound(offsets.begin(), offsets.end(), E.size() * t / num_threads) - offsets.begin();
+        }
+        std::atomic<bool> changed{false};
+        bool round_changed = false;
+        size_t rounds = 0;
+        auto completion = [&]() noexcept {
+            rounds++;
+            round_changed = changed.exchange(false, std::memory_order_relaxed);
+        };
+        std::barrier sync(num_threads, completion);
+        auto work = [&](unsigned t) {
+            do {
+                bool any = false;
+                for (size_t v = first_node[t]; v < first_node[t + 1]; v++) {
+                    std::atomic_ref<uint8_t> mark(lowered[v]);
+                    // the acquire pairs with the release of the thread that lowered v, so the distance read below is at
+                    // least as low as the one it stored. A later lowering marks v again.
+                    if (mark.load(std::memory_order_relaxed) == 0 || mark.exchange(0, std::memory_order_acquire) == 0) {
+                        continue;
+                    }
+                    const double from = std::atomic_ref<double>(min_distances[v]).load(std::memory_order_relaxed);
+                    for (size_t e = offsets[v]; e < offsets[v + 1]; e++) {
+                        if (atomic_min(min_distances[E.targets[e]], from + E.weights[e])) {
+                            std::atomic_ref<uint8_t>(lowered[E.targets[e]]).store(1, std::memory_order_release);
+                            any = true;
+                        }
+                    }
+                }
+                if (any) {
+                    changed.store(true, std::memory_order_relaxed);
+                }
+                // the completion of the barrier publishes round_changed and rounds to all threads alike
+                sync.arrive_and_wait();
+            } while (round_changed && rounds < n);
+        };
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < num_threads; t++) {
+            threads.emplace_back(work, t);
+        }
+        work(0);
+        for (auto & thread : threads) {
+            thread.join();
+        }
+        // without a negative cycle round n - 1 is the last one that can lower a distance
+        return round_changed;
+    }
+}
+
+// num_threads = 0 uses one thread per core.
+template<IsDigraph graph_type>
+void parallel_moore_bellman_ford(const graph_type & G, std::vector<double> & min_distances, const typename graph_type::node_id_type measuring_from,
+    bool & negative_cycle, unsigned num_threads = 0)
+{
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    min_distances[measuring_from] = 0;
+    if (parallel_bellman_ford_detail::relax_rounds(G, min_distances, num_threads)) {
+        negative_cycle = true;
+    }
+}
+
+// Also fills predecessor with a shortest path tree, as dijkstra does. The order in which the threads lower a distance
+// varies from run to run, so the edge that lowered it last is not recorded. Instead, once the distances are final, a
+// breadth first search from measuring_from follows the edges with min_distances[from] + weight == min_distances[to],
+// which gives the same tree in every run and for any number of threads. predecessor is left as it is if there is a
+// negative cycle.
+template<IsDigraph graph_type>
+void parallel_moore_bellman_ford(const graph_type & G, std::vector<double> & min_distances, const typename graph_type::node_id_type measuring_from,
+    std::vector<typename graph_type::node_id_type> & predecessor, bool & negative_cycle, unsigned num_threads = 0)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    bool found_cycle = false;
+    parallel_moore_bellman_ford(G, min_distances, measuring_from, found_cycle, num_threads);
+    if (found_cycle) {
+        negative_cycle = true;
+        return;
+    }
+    std::vector<uint8_t> reached(G.num_nodes(), 0);
+    std::vector<node_id_type> queue{measuring_from};
+    reached[measuring_from] = 1;
+    predecessor[measuring_from] = measuring_from;
+    for (size_t head = 0; head < queue.size(); head++) {
+        const node_id_type node = queue[head];
+        for (const auto & edge : G.adjList(node)) {
+            if (!reached[edge.to] && min_distances[node] + edge.weight == min_distances[edge.to]) {
+                reached[edge.to] = 1;
+                predecessor[edge.to] = node;
+                queue.push_back(edge.to);
+            }
+        }
+    }
+}
+
+#endif //SHORTEST_PATHS_PARALLEL_BELLMAN_FORD_H
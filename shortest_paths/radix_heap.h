@@ -0,0 +1,115 @@
+// Monotone radix heap for unsigned integral keys of 32 or 64 bits. Every pushed key has to be at least the key popped
+// last, which holds for the tentative distances in Dijkstra's algorithm with nonnegative weights. Bucket i > 0 holds the
+// keys whose highest bit differing from the last popped key is bit i-1, bucket 0 the keys equal to it. A pop that finds
+// bucket 0 empty moves the smallest nonempty bucket into lower ones, and since every key can only move down, each one
+// is moved at most once per bit, which gives O(m + n log C) for Dijkstra with maximal distance C.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_RADIX_HEAP_H
+#define SHORTEST_PATHS_RADIX_HEAP_H
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+template<std::unsigned_integral key_type, typename value_type>
+class RadixHeap
+{
+    static constexpr int bits = std::numeric_limits<key_type>::digits;
+    static_assert(bits == 32 || bits == 64, "radix heap keys have 32 or 64 bits");
+
+public:
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    // the key popped last, keys below it cannot be pushed anymore
+    key_type last_key() const
+    {
+        return last;
+    }
+
+    void push(key_type key, value_type value)
+    {
+        assert(key >= last);
+        const int i = bucket_index(key);
+        buckets[i].emplace_back(key, value);
+        if (i > 0) {
+            nonempty |= uint64_t{1} << (i - 1);
+        }
+        count++;
+    }
+
+    // an entry of minimum key, the heap must not be empty
+    std::pair<key_type, value_type> pop()
+    {
+        if (buckets[0].empty()) {
+            redistribute();
+        }
+        const std::pair<key_type, value_type> entry = buckets[0].back();
+        buckets[0].pop_back();
+        count--;
+        return entry;
+    }
+
+    void clear()
+    {
+        for (auto & bucket : buckets) {
+            bucket.clear();
+        }
+        nonempty = 0;
+        count = 0;
+        last = 0;
+    }
+
+private:
+    std::array<std::vector<std::pair<key_type, value_type>>, bits + 1> buckets;
+    // bit i-1 is set if bucket i > 0 is nonempty, so the smallest nonempty bucket is found without scanning
+    uint64_t nonempty = 0;
+    size_t count = 0;
+    key_type last = 0;
+
+    // one more than the position of the highest bit in which key and last differ, found by counting leading zeros
+    int bucket_index(key_type key) const
+    {
+        return bits - std::countl_zero(static_cast<key_type>(key ^ last));
+    }
+
+    // empties the smallest nonempty bucket, whose minimum becomes the new last key. All its keys share the bits above
+    // its index with that minimum, so each one ends up in a strictly lower bucket.
+    void redistribute()
+    {
+        const int i = std::countr_zero(nonempty) + 1;
+        auto & bucket = buckets[i];
+        key_type minimum = bucket.front().first;
+        for (const auto & entry : bucket) {
+            if (entry.first < minimum) {
+                minimum = entry.first;
+            }
+        }
+        last = minimum;
+        for (const auto & entry : bucket) {
+            const int j = bucket_index(entry.first);
+            buckets[j].push_back(entry);
+            if (j > 0) {
+                nonempty |= uint64_t{1} << (j - 1);
+            }
+        }
+        bucket.clear();
+        nonempty &= ~(uint64_t{1} << (i - 1));
+    }
+};
+
+#endif //SHORTEST_PATHS_RADIX_HEAP_H
@@ -0,0 +1,192 @@
+// The shortest path tree of a search from one node, as given by its predecessors, with the children of every node in
+// one array and the depth of every node, so that a path is read off in time linear in its length and all paths can be
+// walked from the root down. write_shortest_paths prints all of them into one buffer, which is written in one go.
+// Author: Georgi Kocharyan
+
+#ifndef SHORTEST_PATHS_SHORTEST_PATH_TREE_H
+#define SHORTEST_PATHS_SHORTEST_PATH_TREE_H
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+template<typename node_id_type>
+class ShortestPathTree
+{
+public:
+    // the parent of the root and of nodes that were not reached
+    static constexpr node_id_type none = std::numeric_limits<node_id_type>::max();
+
+    // predecessor and min_distances as filled by a search from root such as dijkstra. Nodes whose distance is the
+    // maximum of distance_type were not reached, whatever their predecessor entry holds.
+    template<typename distance_type>
+    ShortestPathTree(node_id_type root, std::vector<node_id_type> const & predecessor, std::vector<distance_type> const & min_distances)
+        : root_id(root), parents(predecessor.size(), none), depths(predecessor.size(), none), first_child(predecessor.size() + 1, 0)
+    {
+        const size_t n = predecessor.size();
+        for (size_t v = 0; v < n; v++) {
+            if (v != static_cast<size_t>(root) && min_distances[v] != std::numeric_limits<distance_type>::max()) {
+                parents[v] = predecessor[v];
+                first_child[parents[v] + 1]++;
+            }
+        }
+        for (size_t v = 0; v < n; v++) {
+            first_child[v + 1] += first_child[v];
+        }
+        children.resize(first_child[n]);
+        std::vector<size_t> next = first_child;
+        for (size_t v = 0; v < n; v++) {
+            if (parents[v] != none) {
+                children[next[parents[v]]++] = static_cast<node_id_type>(v);
+            }
+        }
+        // the depths top down, breadth first, with the children array read in the order the queue needs
+        std::vector<node_id_type> queue{root};
+        depths[root] = 0;
+        for (size_t head = 0; head < queue.size(); head++) {
+            const node_id_type node = queue[head];
+            for (const node_id_type child : children_of(node)) {
+                depths[child] = depths[node] + 1;
+                queue.push_back(child);
+            }
+        }
+    }
+
+    node_id_type root() const
+    {
+        return root_id;
+    }
+
+    size_t num_nodes() const
+    {
+        return parents.size();
+    }
+
+    bool reached(node_id_type node) const
+    {
+        return depths[node] != none;
+    }
+
+    node_id_type parent(node_id_type node) const
+    {
+        return parents[node];
+    }
+
+    // the number of edges on the path from the root to a reached node
+    size_t depth(node_id_type node) const
+    {
+        return depths[node];
+    }
+
+    std::span<const node_id_type> children_of(node_id_type node) const
+    {
+        return std::span<const node_id_type>(children).subspan(first_child[node], first_child[node + 1] - first_child[node]);
+    }
+
+    // the nodes of the path from the root to target, both included, or none if target was not reached. Its length is
+    // known from the depth, so it is filled from the back without reversing.
+    std::vector<node_id_type> path(node_id_type target) const
+    {
+        std::vector<node_id_type> nodes;
+        if (!reached(target)) {
+            return nodes;
+        }
+        nodes.resize(depths[target] + 1);
+        for (size_t i = nodes.size(); i-- > 0; target = parents[target]) {
+            nodes[i] = target;
+        }
+        return nodes;
+    }
+
+    // calls visit(node, path) for every reached node, root first and every node before its children, with path the
+    // nodes from the root to node, valid during the call. Apart from the calls this takes O(n) in total.
+    template<typename function>
+    void for_each_path(function && visit) const
+    {
+        std::vector<node_id_type> path{root_id};
+        // next[d] is the position in children of the next child to visit of the node at depth d of path
+        std::vector<size_t> next{first_child[root_id]};
+        visit(root_id, std::span<const node_id_type>(path));
+        while (!path.empty()) {
+            const node_id_type node = path.back();
+            if (next.back() == first_child[node + 1]) {
+                path.pop_back();
+                next.pop_back();
+                continue;
+            }
+            const node_id_type child = children[next.back()++];
+            path.push_back(child);
+            next.push_back(first_child[child]);
+            visit(child, std::span<const node_id_type>(path));
+        }
+    }
+
+private:
+    node_id_type root_id;
+    std::vector<node_id_type> parents;
+    std::vector<node_id_type> depths;
+    // the children of v are children[first_child[v]] to children[first_child[v + 1] - 1]
+    std::vector<size_t> first_child;
+    std::vector<node_id_type> children;
+};
+
+namespace shortest_path_tree_detail
+{
+    // appends a value as operator<< with the default format would print it
+    template<typename value_type>
+    void append(std::string & out, value_type value)
+    {
+        char buffer[32];
+        if constexpr (std::integral<value_type>) {
+            const auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+            out.append(buffer, end);
+        }
+        else {
+            const int length = std::snprintf(buffer, sizeof(buffer), "%g", static_cast<double>(value));
+            out.append(buffer, length);
+        }
+    }
+}
+
+// Writes for every node other than the root, in the order of the node ids, either "v - ... - root is the shortest path
+// with total weight d." or "v is inaccessible from root.", after a line naming the root. The lines are built in one
+// string and written with a single call, in time linear in the length of the output.
+template<typename node_id_type, typename distance_type>
+void write_shortest_paths(std::ostream & out, ShortestPathTree<node_id_type> const & tree, std::vector<distance_type> const & min_distances)
+{
+    using shortest_path_tree_detail::append;
+    const node_id_type root = tree.root();
+    std::string text;
+    append(text, root);
+    text += " is the root node.\n";
+    for (size_t i = 0; i < tree.num_nodes(); i++) {
+        node_id_type node = static_cast<node_id_type>(i);
+        if (node == root) {
+            continue;
+        }
+        append(text, node);
+        if (!tree.reached(node)) {
+            text += " is inaccessible from ";
+            append(text, root);
+            text += ".\n";
+            continue;
+        }
+        for (node = tree.parent(node); node != tree.none; node = tree.parent(node)) {
+            text += " - ";
+            append(text, node);
+        }
+        text += " is the shortest path with total weight ";
+        append(text, min_distances[i]);
+        text += ".\n";
+    }
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    out.flush();
+}
+
+#endif //SHORTEST_PATHS_SHORTEST_PATH_TREE_H
@@ -0,0 +1,220 @@
+// Tests for the all pairs and multi-source shortest paths: Floyd-Warshall with its next hops, Johnson's algorithm and its
+// distance file, and the multi-source searches against a plain Bellman-Ford per source, on random graphs with negative
+// weights, negative cycles and unreachable nodes, on the empty graph, with no sources at all and with Johnson on as many
+// nodes as the node id type can count.
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/floyd_warshall.h"
+#include "shortest_paths/johnson.h"
+#include "shortest_paths/multi_source.h"
+#include "tests/check.h"
+#include "tests/reference.h"
+
+using Graph = Digraph<WeightedEdge<double>>;
+
+// the rows of the reference distances, row s holding the distances from s, and whether any negative cycle exists
+std::vector<std::vector<double>> reference_all_pairs(size_t n, std::vector<TestEdge> const & edges, bool & negative_cycle)
+{
+    std::vector<std::vector<double>> rows;
+    negative_cycle = false;
+    for (size_t source = 0; source < n; source++) {
+        bool cycle = false;
+        rows.push_back(reference_distances(n, edges, source, cycle));
+        negative_cycle = negative_cycle || cycle;
+    }
+    return rows;
+}
+
+// whether the next hops spell out, for every pair, a path of edges whose weight is the distance
+bool paths_match(Graph const & G, NextHopMatrix const & next_hop, std::vector<std::vector<double>> const & expected)
+{
+    for (size_t from = 0; from < expected.size(); from++) {
+        for (size_t to = 0; to < expected.size(); to++) {
+            const std::vector<int32_t> path = next_hop.path(from, to);
+            if (path.empty() != (expected[from][to] == unreachable)) {
+                return false;
+            }
+            double length = 0;
+            for (size_t i = 0; i + 1 < path.size(); i++) {
+                double lightest = unreachable;
+                for (const auto & edge : G.adjList(path[i])) {
+                    if (edge.to == path[i + 1]) {
+                        lightest = std::min(lightest, edge.weight);
+                    }
+                }
+                if (lightest == unreachable) {
+                    return false;
+                }
+                length += lightest;
+            }
+            if (!path.empty() && (path.front() != static_cast<int32_t>(from) || path.back() != static_cast<int32_t>(to)
+                || length != expected[from][to])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void test_floyd_warshall_and_johnson()
+{
+    std::mt19937_64 rng(3);
+    for (unsigned trial = 0; trial < 80; trial++) {
+        const size_t n = trial % 25;
+        std::vector<TestEdge> edges;
+        if (n > 0) {
+            // positive cycles everywhere, made negative by potentials, so the next hops never run around a cycle
+            edges = random_edges(n, rng() % (3 * n), 1, 20, rng);
+            if (trial % 4 == 3) {
+                // some negative cycles, and some graphs that escape them
+                for (auto & edge : edges) {
+                    edge.weight -= 6;
+                }
+            }
+            else {
+                apply_random_potentials(n, edges, rng);
+            }
+        }
+        const std::string name = "random graph " + std::to_string(trial) + " on " + std::to_string(n) + " nodes";
+        bool negative_cycle = false;
+        const auto expected = reference_all_pairs(n, edges, negative_cycle);
+        const Graph G = make_graph<double, int>(n, edges);
+
+        for (const unsigned threads : {1u, 3u}) {
+            NextHopMatrix next_hop;
+            const DistanceMatrix<double> D = floyd_warshall(G, next_hop, threads);
+            bool negative_diagonal = false;
+            for (size_t v = 0; v < n; v++) {
+                negative_diagonal = negative_diagonal || D(v, v) < 0;
+            }
+            check(negative_diagonal == negative_cycle, "floyd-warshall finds the negative cycles of " + name);
+            if (!negative_cycle) {
+                bool same = true;
+                for (size_t from = 0; from < n; from++) {
+                    for (size_t to = 0; to < n; to++) {
+                        same = same && D(to, from) == expected[from][to];
+                    }
+                }
+                check(same, "floyd-warshall distances on " + name);
+                check(paths_match(G, next_hop, expected), "floyd-warshall next hops on " + name);
+            }
+
+            std::vector<std::vector<double>> rows(n);
+            size_t calls = 0;
+            const bool conservative = johnson(G, [&](int source, std::vector<double> const & distances) {
+                rows[source] = distances;
+                calls++;
+            }, threads);
+            check(conservative == !negative_cycle, "johnson finds the negative cycles of " + name);
+            check(negative_cycle ? calls == 0 : (calls == n && rows == expected), "johnson distances on " + name);
+        }
+    }
+}
+
+void test_distance_file()
+{
+    std::mt19937_64 rng(4);
+    std::vector<TestEdge> edges = random_edges(12, 30, 1, 20, rng);
+    apply_random_potentials(12, edges, rng);
+    bool negative_cycle = false;
+    const auto expected = reference_all_pairs(12, edges, negative_cycle);
+    const std::string path = (std::filesystem::temp_directory_path() / "all_pairs_test.bin").string();
+    check(write_all_pairs_distances(make_graph<double, int>(12, edges), path, 2), "writes the distances of a conservative graph");
+    bool same = true;
+    for (uint64_t source = 0; source < 12; source++) {
+        same = same && read_distance_row(path, source) == expected[source];
+    }
+    check(same, "the distance file holds the distances");
+    check_throws<std::invalid_argument>([&] { read_distance_row(path, 12); }, "a row beyond the nodes is rejected");
+
+    const std::vector<TestEdge> cycle = {{0, 1, 1}, {1, 0, -2}};
+    check(!write_all_pairs_distances(make_graph<double, int>(2, cycle), path), "a negative cycle writes no distances");
+    check(!std::filesystem::exists(path), "a negative cycle leaves no file behind");
+}
+
+// Johnson on a graph with as many nodes as the node id type can count
+void test_johnson_full_id_range()
+{
+    std::mt19937_64 rng(6);
+    constexpr size_t n = std::numeric_limits<uint8_t>::max();
+    std::vector<TestEdge> edges = random_edges(n, 2 * n, 1, 20, rng);
+    apply_random_potentials(n, edges, rng);
+    bool negative_cycle = false;
+    const auto expected = reference_all_pairs(n, edges, negative_cycle);
+    const auto G = make_graph<double, uint8_t>(n, edges);
+    std::vector<std::vector<double>> rows(n);
+    const bool conservative = johnson(G, [&](uint8_t source, std::vector<double> const & distances) {
+        rows[source] = distances;
+    }, 2);
+    check(conservative && rows == expected, "johnson distances with uint8_t ids on 255 nodes");
+
+    const std::string path = (std::filesystem::temp_directory_path() / "all_pairs_test_uint8.bin").string();
+    check(write_all_pairs_distances(G, path, 2), "writes the distances with uint8_t ids on 255 nodes");
+    check(read_distance_row(path, n - 1) == expected[n - 1], "the distance file holds the last row with uint8_t ids");
+    std::filesystem::remove(path);
+}
+
+void test_multi_source()
+{
+    std::mt19937_64 rng(5);
+    for (unsigned trial = 0; trial < 60; trial++) {
+        const size_t n = 1 + trial % 40;
+        const std::vector<TestEdge> edges = random_edges(n, rng() % (3 * n), 0, 15, rng);
+        // up to 70 sources, so that the bit-parallel search needs two batches, with repetitions
+        std::vector<int> sources(rng() % 71);
+        for (auto & source : sources) {
+            source = static_cast<int>(rng() % n);
+        }
+        std::vector<TestEdge> unit = edges;
+        for (auto & edge : unit) {
+            edge.weight = 1;
+        }
+        const std::string name = "random graph " + std::to_string(trial) + " with " + std::to_string(sources.size()) + " sources";
+        const Graph G = make_graph<double, int>(n, edges);
+        const CSRDigraph<WeightedEdge<double>> csr(G);
+        const DistanceMatrix<double> D = multi_source_shortest_paths(G, std::span<const int>(sources));
+        const DistanceMatrix<double> csr_D = multi_source_shortest_paths(csr, std::span<const int>(sources));
+        const DistanceMatrix<int> hops = multi_source_bfs(G, std::span<const int>(sources));
+        bool same = true;
+        bool same_hops = true;
+        for (size_t i = 0; i < sources.size(); i++) {
+            bool cycle = false;
+            const std::vector<double> expected = reference_distances(n, edges, sources[i], cycle);
+            const std::vector<double> expected_hops = reference_distances(n, unit, sources[i], cycle);
+            for (size_t v = 0; v < n; v++) {
+                same = same && D(v, i) == expected[v] && csr_D(v, i) == expected[v];
+                same_hops = same_hops && (expected_hops[v] == unreachable ? hops(v, i) == std::numeric_limits<int>::max()
+                    : hops(v, i) == expected_hops[v]);
+            }
+        }
+        check(same, "multi-source distances on " + name);
+        check(same_hops, "multi-source bfs on " + name);
+    }
+
+    const Graph empty(0);
+    check(multi_source_shortest_paths(empty, std::span<const int>()).values.empty(), "multi-source search on the empty graph");
+    check(multi_source_bfs(empty, std::span<const int>()).values.empty(), "multi-source bfs on the empty graph");
+    const Graph G = make_graph<double, int>(3, {{0, 1, 1}});
+    check(multi_source_shortest_paths(G, std::span<const int>()).num_sources == 0, "multi-source search without sources");
+    check(multi_source_bfs(G, std::span<const int>()).num_sources == 0, "multi-source bfs without sources");
+}
+
+int main()
+{
+    test_floyd_warshall_and_johnson();
+    test_distance_file();
+    test_johnson_full_id_range();
+    test_multi_source();
+    return check_result();
+}
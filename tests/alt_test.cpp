@@ -0,0 +1,133 @@
+// Tests for shortest_paths/alt.h: queries agree with dijkstra with and without landmarks, on 8 bit node ids, on graphs
+// where no landmark can be picked, for unreachable targets and on tables passed as temporaries, and landmark files with
+// wrong sizes are rejected.
+// Author: Georgi Kocharyan
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/alt.h"
+#include "shortest_paths/dijkstra.h"
+#include "tests/check.h"
+
+constexpr double unreachable = std::numeric_limits<double>::max();
+
+// every query against dijkstra, and every returned path against its distance
+template<typename graph_type>
+bool agrees_with_dijkstra(graph_type const & G, ALT<graph_type> & alt)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    for (size_t s = 0; s < G.num_nodes(); s++) {
+        std::vector<double> min_distances(G.num_nodes(), unreachable);
+        std::vector<node_id_type> predecessor(G.num_nodes());
+        dijkstra(G, min_distances, static_cast<node_id_type>(s), predecessor);
+        for (size_t t = 0; t < G.num_nodes(); t++) {
+            const auto result = alt.query(static_cast<node_id_type>(s), static_cast<node_id_type>(t));
+            if (result.distance != min_distances[t] || (min_distances[t] == unreachable) != result.path.empty()) {
+                return false;
+            }
+            if (!result.path.empty() && (static_cast<size_t>(result.path.front()) != s || static_cast<size_t>(result.path.back()) != t)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename graph_type>
+bool agrees_with_dijkstra(graph_type const & G, LandmarkTables<typename graph_type::node_id_type> const & tables)
+{
+    ALT<graph_type> alt(G, tables);
+    return agrees_with_dijkstra(G, alt);
+}
+
+template<typename node_id_type>
+Digraph<WeightedEdge<double, node_id_type>> random_graph(size_t n, size_t m, unsigned seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<size_t> node(0, n - 1);
+    std::uniform_int_distribution<int> weight(0, 20);
+    Digraph<WeightedEdge<double, node_id_type>> G(n);
+    for (size_t e = 0; e < m; e++) {
+        G.add_edge(static_cast<node_id_type>(node(rng)), static_cast<node_id_type>(node(rng)), weight(rng));
+    }
+    return G;
+}
+
+void test_queries()
+{
+    // sparse enough that many pairs are unreachable
+    const auto G = random_graph<int>(60, 90, 1);
+    check(agrees_with_dijkstra(G, compute_landmarks(G, 0)), "queries without landmarks are dijkstra");
+    check(agrees_with_dijkstra(G, compute_landmarks(G, 4, LandmarkSelection::avoid, 2)), "queries with avoid landmarks");
+    check(agrees_with_dijkstra(G, compute_landmarks(G, 4, LandmarkSelection::farthest, 2)), "queries with farthest landmarks");
+
+    const auto narrow = random_graph<uint8_t>(200, 600, 2);
+    const auto tables = compute_landmarks(narrow, 3, LandmarkSelection::avoid, 1);
+    check(tables.size() == 3, "landmarks on uint8_t ids");
+    check(agrees_with_dijkstra(narrow, tables), "queries on uint8_t ids");
+
+    // no node has an out-edge, so no landmark is picked
+    Digraph<WeightedEdge<double>> isolated(3);
+    const auto none = compute_landmarks(isolated, 2);
+    check(none.size() == 0, "no landmarks without edges");
+    check(agrees_with_dijkstra(isolated, none), "queries on a graph without edges");
+
+    Digraph<WeightedEdge<double>> empty(0);
+    check(compute_landmarks(empty, 2).size() == 0, "no landmarks on the empty graph");
+
+    check_throws<std::invalid_argument>([&] { ALT<Digraph<WeightedEdge<double>>> alt(isolated, compute_landmarks(G, 2)); },
+        "tables of another graph");
+    LandmarkTables<int> short_tables = compute_landmarks(G, 2);
+    short_tables.to_landmark.pop_back();
+    check_throws<std::invalid_argument>([&] { ALT<Digraph<WeightedEdge<double, int>>> alt(G, short_tables); }, "tables missing an entry");
+}
+
+void test_landmark_files()
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "alt_test.landmarks";
+    const auto G = random_graph<int>(30, 80, 3);
+    const auto tables = compute_landmarks(G, 3);
+    write_landmarks(tables, path.string());
+    const auto read = read_landmarks<int>(path.string());
+    check(read.landmarks == tables.landmarks && read.from_landmark == tables.from_landmark && read.to_landmark == tables.to_landmark,
+        "landmark tables read back unchanged");
+    // the search keeps the tables it is given, even straight from the file
+    ALT<Digraph<WeightedEdge<double, int>>> alt(G, read_landmarks<int>(path.string()));
+    check(agrees_with_dijkstra(G, alt), "queries on tables read into the search directly");
+
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto rejected = [&](std::string const & changed, std::string const & what, std::source_location where = std::source_location::current()) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(changed.data(), static_cast<std::streamsize>(changed.size()));
+        check_throws<std::runtime_error>([&] { read_landmarks<int>(path.string()); }, what, where);
+    };
+    auto with_size = [&](size_t position, uint64_t value) {
+        std::string changed = bytes;
+        std::memcpy(changed.data() + position, &value, sizeof(value));
+        return changed;
+    };
+    rejected(bytes.substr(0, bytes.size() - 8), "a truncated landmark file");
+    rejected(with_size(offsetof(LandmarkFileHeader, num_nodes), uint64_t(1) << 62), "a node count beyond the file");
+    rejected(with_size(offsetof(LandmarkFileHeader, num_landmarks), uint64_t(1) << 61), "a landmark count whose tables overflow");
+    rejected(with_size(offsetof(LandmarkFileHeader, num_landmarks), 2), "fewer landmarks than the file holds");
+    std::filesystem::remove(path);
+}
+
+int main()
+{
+    test_queries();
+    test_landmark_files();
+    return check_result();
+}
@@ -0,0 +1,101 @@
+// Tests for graph_io/binary_graph.h: a written graph maps back unchanged, and corrupt or truncated files are rejected
+// when they are mapped.
+// Author: Georgi Kocharyan
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <source_location>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "graph_io/binary_graph.h"
+#include "tests/check.h"
+
+using Graph = CSRDigraph<WeightedEdge<int>>;
+
+std::string read_file(std::filesystem::path const & path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+void write_file(std::filesystem::path const & path, std::string const & bytes)
+{
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+template<typename value_type>
+void overwrite(std::string & bytes, size_t position, value_type value)
+{
+    std::memcpy(bytes.data() + position, &value, sizeof(value));
+}
+
+int main()
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::filesystem::path path = directory / "binary_graph_test.bin";
+    const std::filesystem::path corrupt = directory / "binary_graph_test_corrupt.bin";
+
+    constexpr size_t n = 4;
+    const Graph G(n, {{0, 1, 5}, {0, 2, 1}, {2, 1, 3}, {1, 3, 2}});
+    write_binary_graph(G, path.string());
+    const Graph mapped = map_binary_graph<WeightedEdge<int>>(path.string());
+    check(mapped.num_nodes() == n && mapped.num_edges() == 4 && mapped.get_max() == 5, "the mapped graph has the written sizes");
+    bool same = true;
+    for (int v = 0; v < static_cast<int>(n); v++) {
+        auto a = G.adjList(v).begin();
+        for (const auto & edge : mapped.adjList(v)) {
+            same = same && a != G.adjList(v).end() && edge.to == (*a).to && edge.weight == (*a).weight;
+            ++a;
+        }
+    }
+    check(same, "the mapped graph has the written edges");
+
+    // the arrays start at multiples of 64 bytes after the 56 byte header
+    const std::string bytes = read_file(path);
+    const size_t num_nodes_at = offsetof(BinaryGraphHeader, num_nodes);
+    const size_t num_edges_at = offsetof(BinaryGraphHeader, num_edges);
+    const size_t offsets_at = binary_graph_align(sizeof(BinaryGraphHeader));
+    const size_t targets_at = binary_graph_align(offsets_at + (n + 1) * sizeof(int));
+    const size_t weights_at = binary_graph_align(targets_at + 4 * sizeof(int));
+    auto rejected = [&](std::string const & changed, std::string const & what, std::source_location where = std::source_location::current()) {
+        write_file(corrupt, changed);
+        check_throws<std::runtime_error>([&] { map_binary_graph<WeightedEdge<int>>(corrupt.string()); }, what, where);
+    };
+
+    rejected(bytes.substr(0, targets_at + 2), "a truncated file");
+    std::string changed = bytes;
+    overwrite<uint64_t>(changed, num_nodes_at, std::numeric_limits<uint64_t>::max());
+    rejected(changed, "a node count whose array size overflows");
+    changed = bytes;
+    overwrite<uint64_t>(changed, num_edges_at, uint64_t(1) << 61);
+    rejected(changed, "an edge count whose array size overflows");
+    changed = bytes;
+    overwrite<int>(changed, offsets_at, 1);
+    rejected(changed, "offsets that do not start at 0");
+    changed = bytes;
+    overwrite<int>(changed, offsets_at + 2 * sizeof(int), 0);
+    rejected(changed, "decreasing offsets");
+    changed = bytes;
+    overwrite<int>(changed, offsets_at + n * sizeof(int), 3);
+    rejected(changed, "offsets that end before the last edge");
+    changed = bytes;
+    overwrite<int>(changed, targets_at + sizeof(int), static_cast<int>(n));
+    rejected(changed, "a target that is not a node");
+    changed = bytes;
+    overwrite<int>(changed, targets_at, -1);
+    rejected(changed, "a negative target");
+    changed = bytes;
+    overwrite<int>(changed, weights_at, 6);
+    rejected(changed, "a weight above the maximum of the header");
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(corrupt);
+    return check_result();
+}
@@ -0,0 +1,49 @@
+// Minimal checks for the tests in this directory: every failed check is reported with its location and counted, and
+// a test's main returns check_result(), so that ctest sees the failure.
+// Author: Georgi Kocharyan
+
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <iostream>
+#include <source_location>
+#include <string>
+
+inline int & failed_checks()
+{
+    static int failed = 0;
+    return failed;
+}
+
+inline void check(bool condition, std::string const & what, std::source_location where = std::source_location::current())
+{
+    if (!condition) {
+        std::cerr << where.file_name() << ":" << where.line() << ": check failed: " << what << std::endl;
+        failed_checks()++;
+    }
+}
+
+// calls f and checks that it throws an exception of type exception_type
+template<typename exception_type, typename function>
+void check_throws(function && f, std::string const & what, std::source_location where = std::source_location::current())
+{
+    bool thrown = false;
+    try {
+        f();
+    }
+    catch (exception_type const &) {
+        thrown = true;
+    }
+    check(thrown, what, where);
+}
+
+inline int check_result()
+{
+    if (failed_checks() > 0) {
+        std::cerr << failed_checks() << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+#endif //TESTS_CHECK_H
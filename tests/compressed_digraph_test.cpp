@@ -0,0 +1,122 @@
+// Tests for CompressedDigraph: with both gap encodings, the out- and in-edges, degrees and indegrees of random graphs
+// with loops, parallel edges, isolated nodes and gaps of one to three bytes match the Digraph they were built from or
+// the edge list, also on uint16_t ids, and graphs that do not fit the offset or node id type are rejected.
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "compressed_digraph.h"
+#include "digraph.h"
+#include "tests/check.h"
+#include "tests/reference.h"
+
+// the edges at every node as sorted (from, to) pairs, out-edges or in-edges
+template<typename graph_type>
+std::vector<std::vector<std::pair<size_t, size_t>>> edge_lists(graph_type const & G, bool in_edges)
+{
+    std::vector<std::vector<std::pair<size_t, size_t>>> lists(G.num_nodes());
+    for (size_t v = 0; v < G.num_nodes(); v++) {
+        auto add = [&](auto const & range) {
+            for (const auto & edge : range) {
+                lists[v].emplace_back(edge.from, edge.to);
+            }
+        };
+        const auto node = static_cast<typename graph_type::node_id_type>(v);
+        if (in_edges) {
+            add(G.inAdjList(node));
+        }
+        else {
+            add(G.adjList(node));
+        }
+        std::sort(lists[v].begin(), lists[v].end());
+    }
+    return lists;
+}
+
+template<typename node_id_type, typename offset_type>
+void check_compressed(Digraph<WeightedEdge<double, node_id_type>> const & G, CompressedDigraph<node_id_type, offset_type> const & C,
+    std::string const & name)
+{
+    bool same_degrees = C.num_nodes() == G.num_nodes() && C.num_edges() == static_cast<offset_type>(G.num_edges());
+    for (size_t v = 0; same_degrees && v < G.num_nodes(); v++) {
+        same_degrees = C.outdeg(static_cast<node_id_type>(v)) == static_cast<offset_type>(G.adjList(static_cast<node_id_type>(v)).size());
+    }
+    check(same_degrees, "the sizes and degrees of " + name);
+    check(edge_lists(C, false) == edge_lists(G, false), "the out-edges of " + name);
+
+    // indegrees are counted from the out-edges until the reverse index exists, and read from it afterwards
+    std::vector<typename CompressedDigraph<node_id_type, offset_type>::edge_count_type> expected(G.num_nodes(), 0);
+    for (size_t v = 0; v < G.num_nodes(); v++) {
+        expected[v] = G.inAdjList(static_cast<node_id_type>(v)).size();
+    }
+    check(C.indegrees() == expected, "the indegrees of " + name);
+    check(edge_lists(C, true) == edge_lists(G, true), "the in-edges of " + name);
+    check(C.indegrees() == expected, "the indegrees from the reverse index of " + name);
+}
+
+template<typename node_id_type>
+void check_random_graphs(std::mt19937_64 & rng)
+{
+    for (unsigned trial = 0; trial < 40; trial++) {
+        // up to 60000 nodes, so that the gaps between sorted targets take one to three bytes
+        const size_t n = 1 + (trial % 4 == 3 ? rng() % 60000 : trial % 30);
+        const std::vector<TestEdge> edges = random_edges(n, rng() % (3 * n), 0, 0, rng);
+        const auto G = make_graph<double, node_id_type>(n, edges);
+        std::vector<BasicEdge<node_id_type>> edge_list;
+        for (auto const & edge : edges) {
+            edge_list.emplace_back(static_cast<node_id_type>(edge.from), static_cast<node_id_type>(edge.to));
+        }
+        const std::string name = "random graph " + std::to_string(trial) + " on " + std::to_string(n) + " nodes";
+        for (const auto encoding : {GapEncoding::varint, GapEncoding::group_varint}) {
+            const std::string encoded = name + (encoding == GapEncoding::varint ? " with varints" : " with group varints");
+            check_compressed(G, CompressedDigraph<node_id_type>(G, encoding), encoded);
+            check_compressed(G, CompressedDigraph<node_id_type, uint32_t>(n, edge_list, encoding), encoded + " from its edge list");
+        }
+    }
+}
+
+void test_round_trips()
+{
+    std::mt19937_64 rng(10);
+    check_random_graphs<int>(rng);
+    check_random_graphs<uint16_t>(rng);
+
+    // large gaps in both directions, and a first target far below its node
+    const std::vector<TestEdge> edges = {{0, 69999, 0}, {0, 1, 0}, {1, 59999, 0}, {1, 0, 0}, {1, 300, 0}, {69999, 0, 0},
+        {69999, 69999, 0}, {40000, 3, 0}, {40000, 40000, 0}, {40000, 39999, 0}};
+    const auto G = make_graph<double, int>(70000, edges);
+    check_compressed(G, CompressedDigraph<int>(G, GapEncoding::varint), "large gaps with varints");
+    check_compressed(G, CompressedDigraph<int>(G, GapEncoding::group_varint), "large gaps with group varints");
+}
+
+void test_limits()
+{
+    // a loop takes 2 bytes, so 127 of them end at offset 254, 128 end past the limit of one byte and 129 start past it
+    std::vector<BasicEdge<int>> loops;
+    for (int v = 0; v < 129; v++) {
+        loops.emplace_back(v, v);
+    }
+    const std::vector<BasicEdge<int>> fitting(loops.begin(), loops.end() - 2);
+    const std::vector<BasicEdge<int>> ending_past(loops.begin(), loops.end() - 1);
+    check(CompressedDigraph<int, uint8_t>(127, fitting).num_edges() == 127, "a graph just small enough for offsets of one byte");
+    check_throws<std::length_error>([&] { CompressedDigraph<int, uint8_t>(128, ending_past); }, "a last list that ends past the offset type");
+    check_throws<std::length_error>([&] { CompressedDigraph<int, uint8_t>(129, loops); }, "a list that starts past the offset type");
+
+    const Digraph<WeightedEdge<double, int>> wide(300);
+    check_throws<std::length_error>([&] { CompressedDigraph<uint8_t>{wide}; }, "a graph with more nodes than uint8_t ids");
+    check_throws<std::length_error>([] { CompressedDigraph<uint8_t>(300, std::vector<BasicEdge<uint8_t>>()); },
+        "an edge list with more nodes than uint8_t ids");
+}
+
+int main()
+{
+    test_round_trips();
+    test_limits();
+    return check_result();
+}
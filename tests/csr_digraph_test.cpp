@@ -0,0 +1,45 @@
+// Tests for the in-edges of CSRDigraph: they match the out-edges of the transpose, also on a transpose taken after the
+// reverse index of the original graph was built, and on a copy that shares the index.
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "digraph.h"
+#include "tests/check.h"
+
+using Graph = CSRDigraph<WeightedEdge<int>>;
+
+// the in-edges of node_id as sorted (from, to, weight) triples
+std::vector<std::pair<std::pair<int, int>, int>> in_edges(Graph const & G, int node_id)
+{
+    std::vector<std::pair<std::pair<int, int>, int>> edges;
+    for (const auto & edge : G.inAdjList(node_id)) {
+        edges.push_back({{edge.from, edge.to}, edge.weight});
+    }
+    std::ranges::sort(edges);
+    return edges;
+}
+
+int main()
+{
+    const Graph G(3, {{0, 1, 4}, {0, 2, 7}, {1, 2, 1}});
+    const Graph fresh = G.transpose();
+    check(in_edges(fresh, 0) == std::vector<std::pair<std::pair<int, int>, int>>{{{1, 0}, 4}, {{2, 0}, 7}},
+        "the transpose has the reversed edges into node 0");
+    check(in_edges(fresh, 2).empty(), "the transpose has no edges into node 2");
+
+    G.index_in_edges();
+    check(in_edges(G, 2) == std::vector<std::pair<std::pair<int, int>, int>>{{{0, 2}, 7}, {{1, 2}, 1}},
+        "the indexed graph has the edges into node 2");
+    const Graph copy = G;
+    check(in_edges(copy, 2) == in_edges(G, 2), "a copy shares the in-edges of the indexed graph");
+
+    // the transpose must not keep the reverse index of G, which describes other arrays
+    const Graph T = G.transpose();
+    for (int v = 0; v < 3; v++) {
+        check(in_edges(T, v) == in_edges(fresh, v), "a transpose taken after indexing has the in-edges of a fresh one");
+    }
+    return check_result();
+}
@@ -0,0 +1,112 @@
+// Tests for DynamicShortestPaths: batches of weight changes on random graphs with loops, parallel edges, zero weights and
+// unreachable nodes, including edges into and out of the root, are repaired to the distances of a plain Bellman-Ford and
+// to a tree with predecessor[root] = root, as dijkstra leaves it. set_weight has to refuse to run without the in-edge
+// index instead of building it on the quiet.
+// Author: Georgi Kocharyan
+
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/dynamic_shortest_paths.h"
+#include "shortest_paths/shortest_path_tree.h"
+#include "tests/check.h"
+#include "tests/reference.h"
+
+using Graph = Digraph<WeightedEdge<double>>;
+using Paths = DynamicShortestPaths<Graph>;
+
+// whether the predecessors of paths form a shortest path tree of G for expected
+bool is_tree(Graph const & G, Paths const & paths, int root, std::vector<double> const & expected)
+{
+    if (paths.distances() != expected || paths.predecessors()[root] != root) {
+        return false;
+    }
+    for (size_t v = 0; v < G.num_nodes(); v++) {
+        const int parent = paths.predecessors()[v];
+        if (expected[v] == unreachable) {
+            if (parent != Paths::none) {
+                return false;
+            }
+            continue;
+        }
+        if (static_cast<int>(v) == root) {
+            continue;
+        }
+        bool tight = false;
+        for (const auto & edge : G.adjList(parent)) {
+            tight = tight || (static_cast<size_t>(edge.to) == v && expected[parent] + edge.weight == expected[v]);
+        }
+        if (!tight) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_repairs()
+{
+    std::mt19937_64 rng(8);
+    for (unsigned trial = 0; trial < 100; trial++) {
+        const size_t n = 1 + trial % 30;
+        std::vector<TestEdge> edges = random_edges(n, rng() % (3 * n) + 1, 0, 20, rng);
+        const int root = static_cast<int>(rng() % n);
+        Graph G = make_graph<double, int>(n, edges);
+        Paths paths(G, root);
+        const std::string name = "random graph " + std::to_string(trial);
+        bool cycle = false;
+        check(is_tree(G, paths, root, reference_distances(n, edges, root, cycle)), "the first search on " + name);
+
+        for (unsigned batch = 0; batch < 8; batch++) {
+            std::vector<WeightChange<double, int>> changes;
+            for (size_t i = rng() % 5 + 1; i > 0; i--) {
+                TestEdge const & edge = edges[rng() % edges.size()];
+                const double weight = static_cast<double>(rng() % 21);
+                changes.push_back({static_cast<int>(edge.from), static_cast<int>(edge.to), weight});
+                // a loop at the root, where the convention for its predecessor matters, if there is one
+                if (i % 4 == 0) {
+                    changes.push_back({root, root, weight});
+                }
+            }
+            // set_weight gives all parallel edges the new weight
+            for (const auto & change : changes) {
+                for (auto & edge : edges) {
+                    if (static_cast<int>(edge.from) == change.from && static_cast<int>(edge.to) == change.to) {
+                        edge.weight = static_cast<int>(change.weight);
+                    }
+                }
+            }
+            paths.update(std::span<const WeightChange<double, int>>(changes));
+            check(is_tree(G, paths, root, reference_distances(n, edges, root, cycle)),
+                "the repair of batch " + std::to_string(batch) + " on " + name);
+        }
+        const ShortestPathTree<int> tree(root, paths.predecessors(), paths.distances());
+        check(tree.depth(root) == 0, "the tree of the repaired paths has its root at depth 0 on " + name);
+    }
+}
+
+void test_in_edge_index()
+{
+    Graph G = make_graph<double, int>(3, {{0, 1, 4}, {1, 2, 1}, {0, 2, 9}});
+    check_throws<std::logic_error>([&] { G.set_weight(0, 1, 2); }, "set_weight without the in-edge index throws");
+    G.index_in_edges();
+    check(G.set_weight(0, 1, 2) == 4, "set_weight returns the old weight once the index exists");
+    check(G.set_weight(1, 0, 2) == std::numeric_limits<double>::max(), "set_weight of an edge that does not exist");
+
+    Graph H = make_graph<double, int>(3, {{0, 1, 4}, {1, 2, 1}});
+    Paths paths(H, 0);
+    const std::vector<WeightChange<double, int>> changes = {{1, 2, 7}};
+    paths.update(std::span<const WeightChange<double, int>>(changes));
+    check(paths.distances()[2] == 11, "DynamicShortestPaths builds the in-edge index itself");
+}
+
+int main()
+{
+    test_repairs();
+    test_in_edge_index();
+    return check_result();
+}
@@ -0,0 +1,134 @@
+// Tests for graph_io/edge_list_reader.h: reads that do not depend on the number of threads, node ids that do not fit
+// the node id type, flow terminals outside the graph and METIS input without a header.
+// Author: Georgi Kocharyan
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "graph_io/edge_list_reader.h"
+#include "tests/check.h"
+
+template<typename weight_type, typename node_id_type>
+bool same_edges(EdgeListFile<weight_type, node_id_type> const & a, EdgeListFile<weight_type, node_id_type> const & b)
+{
+    if (a.num_nodes != b.num_nodes || a.edges.size() != b.edges.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.edges.size(); i++) {
+        if (a.edges[i].from != b.edges[i].from || a.edges[i].to != b.edges[i].to || a.edges[i].weight != b.edges[i].weight) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// a METIS ring with comments between the node lines, one of them indented, and an isolated node given by an empty line
+void test_metis_threads(std::filesystem::path const & path)
+{
+    constexpr size_t n = 20000;
+    std::string text = "% a ring\n" + std::to_string(n) + " " + std::to_string(n - 1) + "\n";
+    for (size_t v = 0; v < n; v++) {
+        if (v == n / 3) {
+            text += "   % an indented comment\n";
+        }
+        if (v == n / 2) {
+            text += "\t%another one\n";
+        }
+        if (v == n - 1) {
+            text += "\n";
+            continue;
+        }
+        // nodes are numbered from 1, the last one is isolated
+        if (v > 0) {
+            text += std::to_string(v) + " ";
+        }
+        if (v + 2 < n) {
+            text += std::to_string(v + 2);
+        }
+        text += "\n";
+    }
+    std::ofstream(path) << text;
+
+    const auto single = read_edge_list<int>(path.string(), GraphFormat::metis, 1);
+    check(single.num_nodes == n, "the METIS file has n nodes");
+    check(single.edges.size() == 2 * (n - 2), "every ring edge is read in both directions");
+    bool numbered = true;
+    for (auto const & edge : single.edges) {
+        numbered = numbered && (edge.to == edge.from + 1 || edge.to + 1 == edge.from) && edge.from < static_cast<int>(n - 1);
+    }
+    check(numbered, "the METIS lines are numbered without the comments");
+    for (const unsigned threads : {2u, 4u, 7u}) {
+        check(same_edges(single, read_edge_list<int>(path.string(), GraphFormat::metis, threads)),
+            "a mapped METIS file reads the same on " + std::to_string(threads) + " threads");
+        std::istringstream in(text);
+        check(same_edges(single, read_edge_list<int>(in, GraphFormat::metis, threads, 4096)),
+            "a METIS stream reads the same on " + std::to_string(threads) + " threads");
+    }
+}
+
+void test_node_id_range()
+{
+    std::istringstream fits("0 1\n65534 2\n");
+    const auto file = read_edge_list<int, uint16_t>(fits, GraphFormat::snap, 1);
+    check(file.num_nodes == 65535, "the largest id that fits a uint16_t graph");
+
+    check_throws<std::out_of_range>([] {
+        std::istringstream in("0 1\n70000 2\n");
+        read_edge_list<int, uint16_t>(in, GraphFormat::snap, 1);
+    }, "a SNAP id above the range of uint16_t");
+    check_throws<std::out_of_range>([] {
+        std::istringstream in("p sp 3 1\na 1 65536 4\n");
+        read_edge_list<int, uint16_t>(in, GraphFormat::dimacs, 1);
+    }, "a DIMACS id equal to the maximum of uint16_t");
+    check_throws<std::out_of_range>([] {
+        std::istringstream in("2 1\n1000000\n1\n");
+        read_edge_list<int, uint16_t>(in, GraphFormat::metis, 1);
+    }, "a METIS neighbour above the range of uint16_t");
+}
+
+void test_malformed(std::filesystem::path const & path)
+{
+    std::istringstream flow("p max 3 1\nn 1 s\nn 3 t\na 1 2 5\n");
+    const auto network = read_edge_list<int>(flow, GraphFormat::dimacs_flow, 1);
+    check(network.source == 0 && network.sink == 2, "the flow terminals are numbered from 0");
+    check_throws<std::runtime_error>([] {
+        std::istringstream in("p max 3 1\nn 4294967297 s\na 1 2 5\n");
+        read_edge_list<int>(in, GraphFormat::dimacs_flow, 1);
+    }, "a flow source above the range of int");
+    // with 64-bit ids the terminals may lie beyond the range of int as well
+    std::istringstream wide("p max 3000000002 1\nn 3000000001 s\nn 3000000002 t\na 3000000001 1 5\n");
+    const auto wide_network = read_edge_list<int, int64_t>(wide, GraphFormat::dimacs_flow, 1);
+    check(wide_network.source == 3000000000 && wide_network.sink == 3000000001, "flow terminals above the range of int with int64_t ids");
+    check_throws<std::runtime_error>([] {
+        std::istringstream in("p max 3 1\nn 1 s\nn 5 t\na 1 2 5\n");
+        read_edge_list<int>(in, GraphFormat::dimacs_flow, 1);
+    }, "a flow sink that is no node of the graph");
+    check_throws<std::runtime_error>([] {
+        std::istringstream in("p max 3 1\nn 0 s\na 1 2 5\n");
+        read_edge_list<int>(in, GraphFormat::dimacs_flow, 1);
+    }, "a flow source numbered from 0");
+
+    std::istringstream header_only("3 0");
+    check(read_edge_list<int>(header_only, GraphFormat::metis, 1).num_nodes == 3, "a METIS header without a newline");
+    check_throws<std::runtime_error>([] {
+        std::istringstream in("% only\n% comments");
+        read_edge_list<int>(in, GraphFormat::metis, 1, 4);
+    }, "a METIS stream without a header");
+    std::ofstream(path) << "% only\n% comments";
+    check_throws<std::runtime_error>([&] { read_edge_list<int>(path.string(), GraphFormat::metis, 1); },
+        "a METIS file without a header");
+}
+
+int main()
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "edge_list_reader_test.metis";
+    test_metis_threads(path);
+    test_malformed(path);
+    std::filesystem::remove(path);
+    test_node_id_range();
+    return check_result();
+}
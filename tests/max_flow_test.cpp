@@ -0,0 +1,92 @@
+// Tests for push_relabel against augmenting paths on a capacity matrix, on random networks with loops, parallel and
+// antiparallel edges, zero capacities and sinks the source cannot reach, for source == sink, and on narrow node ids.
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "max_flows/flow_check.h"
+#include "max_flows/push_relabel.h"
+#include "tests/check.h"
+#include "tests/reference.h"
+
+// the value of a maximum flow by shortest augmenting paths on the residual capacities between every pair of nodes
+double reference_max_flow(size_t n, std::vector<TestEdge> const & edges, size_t source, size_t sink)
+{
+    if (source == sink) {
+        return 0;
+    }
+    std::vector<std::vector<double>> residual(n, std::vector<double>(n, 0));
+    for (auto const & edge : edges) {
+        if (edge.from != edge.to) {
+            residual[edge.from][edge.to] += edge.weight;
+        }
+    }
+    double value = 0;
+    while (true) {
+        std::vector<size_t> parent(n, n);
+        parent[source] = source;
+        std::queue<size_t> queue;
+        queue.push(source);
+        while (!queue.empty() && parent[sink] == n) {
+            const size_t v = queue.front();
+            queue.pop();
+            for (size_t w = 0; w < n; w++) {
+                if (parent[w] == n && residual[v][w] > 0) {
+                    parent[w] = v;
+                    queue.push(w);
+                }
+            }
+        }
+        if (parent[sink] == n) {
+            return value;
+        }
+        double augment = unreachable;
+        for (size_t v = sink; v != source; v = parent[v]) {
+            augment = std::min(augment, residual[parent[v]][v]);
+        }
+        for (size_t v = sink; v != source; v = parent[v]) {
+            residual[parent[v]][v] -= augment;
+            residual[v][parent[v]] += augment;
+        }
+        value += augment;
+    }
+}
+
+template<typename node_id_type>
+void check_flow(size_t n, std::vector<TestEdge> const & edges, size_t source, size_t sink, std::string const & name)
+{
+    Digraph<NetworkEdge<double, node_id_type>> G(n);
+    for (auto const & edge : edges) {
+        G.add_edge(static_cast<node_id_type>(edge.from), static_cast<node_id_type>(edge.to), edge.weight, 0);
+    }
+    const double expected = reference_max_flow(n, edges, source, sink);
+    const double value = push_relabel(G, static_cast<node_id_type>(source), static_cast<node_id_type>(sink));
+    check(value == expected, "push-relabel value on " + name);
+    check(is_flow(G, source, sink, value), "push-relabel flow on " + name);
+}
+
+int main()
+{
+    std::mt19937_64 rng(7);
+    for (unsigned trial = 0; trial < 300; trial++) {
+        const size_t n = 1 + trial % 25;
+        // integral capacities keep every value exact, sparse networks often separate the sink from the source
+        const auto edges = random_edges(n, rng() % (4 * n), 0, trial % 2 == 0 ? 3 : 100, rng);
+        const size_t source = rng() % n;
+        const size_t sink = trial % 10 == 0 ? source : rng() % n;
+        const std::string name = "random network " + std::to_string(trial);
+        check_flow<int>(n, edges, source, sink, name);
+        check_flow<uint16_t>(n, edges, source, sink, name + " with uint16_t ids");
+        check_flow<uint8_t>(n, edges, source, sink, name + " with uint8_t ids");
+    }
+    check_flow<int>(2, {}, 0, 1, "two nodes without edges");
+    check_flow<int>(2, {{1, 0, 5}}, 0, 1, "an edge against the direction of the flow");
+    check_flow<int>(2, {{0, 1, 5}, {1, 0, 3}, {0, 1, 2}, {0, 0, 9}}, 0, 1, "antiparallel, parallel edges and a loop");
+    return check_result();
+}
@@ -0,0 +1,90 @@
+// Tests for graphs on node id types other than int: node counts up to the maximum of the type, the rejection of larger
+// ones and of edge counts that do not fit the offsets of a CSR graph, and shortest paths on 16 and 32 bit ids.
+// Author: Georgi Kocharyan
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/dijkstra.h"
+#include "tests/check.h"
+
+void test_node_counts()
+{
+    check_throws<std::length_error>([] { Digraph<BasicEdge<uint16_t>> G(65536); }, "65536 nodes do not fit uint16_t");
+    check_throws<std::length_error>([] { Digraph<WeightedEdge<int, uint16_t>> G(70000); }, "70000 weighted nodes do not fit uint16_t");
+    check_throws<std::length_error>([] { Digraph<BasicEdge<int8_t>> G(128); }, "128 nodes do not fit int8_t");
+    check_throws<std::length_error>([] { CSRDigraph<WeightedEdge<int, uint16_t>> G(65536, {}); }, "65536 CSR nodes do not fit uint16_t");
+    check_throws<std::length_error>([] { CSRDigraph<WeightedEdge<int>, int8_t>(1, std::vector<WeightedEdge<int>>(128, {0, 0, 1})); },
+        "128 CSR edges do not fit int8_t offsets");
+    check_throws<std::length_error>([] {
+        Digraph<WeightedEdge<int>> G(1);
+        for (int i = 0; i < 128; i++) {
+            G.add_edge(0, 0, 1);
+        }
+        CSRDigraph<WeightedEdge<int>, int8_t>{G};
+    }, "128 edges of a Digraph do not fit int8_t offsets");
+    check(CSRDigraph<WeightedEdge<int>, int8_t>(1, std::vector<WeightedEdge<int>>(127, {0, 0, 1})).num_edges() == 127,
+        "127 CSR edges fit int8_t offsets");
+
+    Digraph<BasicEdge<uint16_t>> G(65535);
+    G.add_edge(65534, 0);
+    check(G.num_nodes() == 65535, "the largest graph on uint16_t ids");
+    const Digraph<BasicEdge<uint16_t>> copy(G);
+    check(copy.num_nodes() == 65535 && copy.num_edges() == 1, "copying the largest graph on uint16_t ids");
+    size_t in_edges = 0;
+    for (const auto & edge : G.inAdjList(0)) {
+        in_edges += edge.from == 65534;
+    }
+    check(in_edges == 1, "the in-edges of the largest graph on uint16_t ids");
+}
+
+// a path through all nodes of the largest graph on uint16_t ids
+template<typename graph_type>
+void check_path_distances(graph_type const & G)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    std::vector<double> min_distances(G.num_nodes(), std::numeric_limits<double>::max());
+    std::vector<node_id_type> predecessor(G.num_nodes());
+    dijkstra(G, min_distances, 0, predecessor);
+    bool exact = true;
+    for (size_t v = 1; v < G.num_nodes(); v++) {
+        exact = exact && min_distances[v] == 2.0 * v && predecessor[v] == v - 1;
+    }
+    check(exact, "the distances along a path over all uint16_t ids");
+}
+
+void test_dijkstra_uint16()
+{
+    constexpr size_t n = std::numeric_limits<uint16_t>::max();
+    Digraph<WeightedEdge<int, uint16_t>> G(n);
+    for (size_t v = 0; v + 1 < n; v++) {
+        G.add_edge(static_cast<uint16_t>(v), static_cast<uint16_t>(v + 1), 2);
+    }
+    check_path_distances(G);
+    check_path_distances(CSRDigraph<WeightedEdge<int, uint16_t>>(G));
+}
+
+void test_dijkstra_uint32()
+{
+    Digraph<WeightedEdge<double, uint32_t>, uint64_t> G(5);
+    G.add_edge(0, 1, 4);
+    G.add_edge(0, 2, 1);
+    G.add_edge(2, 1, 2);
+    G.add_edge(1, 3, 1);
+    std::vector<double> min_distances(5, std::numeric_limits<double>::max());
+    std::vector<uint32_t> predecessor(5);
+    dijkstra(G, min_distances, 0, predecessor);
+    check(min_distances[1] == 3 && min_distances[3] == 4 && predecessor[1] == 2 && predecessor[3] == 1, "dijkstra on uint32_t ids");
+    check(min_distances[4] == std::numeric_limits<double>::max(), "an unreachable node on uint32_t ids");
+}
+
+int main()
+{
+    test_node_counts();
+    test_dijkstra_uint16();
+    test_dijkstra_uint32();
+    return check_result();
+}
@@ -0,0 +1,106 @@
+// Tests for the node orders and the relabelling on small random graphs with loops, parallel edges and isolated nodes:
+// every order is a permutation, relabelling by the inverse order gives the graph back, and distances and predecessors
+// computed on the relabelled graph translate back to the old ids, the marker of unreachable nodes included.
+// Author: Georgi Kocharyan
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "digraph.h"
+#include "reordering/node_order.h"
+#include "shortest_paths/dijkstra.h"
+#include "tests/check.h"
+#include "tests/reference.h"
+
+// the out-edges of every node in their order, as targets and weights
+template<typename graph_type>
+std::vector<std::vector<std::pair<size_t, double>>> out_edges(graph_type const & G)
+{
+    std::vector<std::vector<std::pair<size_t, double>>> lists(G.num_nodes());
+    for (size_t v = 0; v < G.num_nodes(); v++) {
+        for (const auto & edge : G.adjList(v)) {
+            lists[v].emplace_back(edge.to, edge.weight);
+        }
+    }
+    return lists;
+}
+
+template<typename graph_type>
+void check_relabel(graph_type const & G, NodeOrder method, std::vector<TestEdge> const & edges, std::string const & name)
+{
+    using node_id_type = typename graph_type::node_id_type;
+    constexpr node_id_type none = std::numeric_limits<node_id_type>::max();
+    const size_t n = G.num_nodes();
+    const std::vector<node_id_type> order = compute_node_order(G, method);
+    const std::vector<node_id_type> position = inverse_order(order);
+    bool permutation = order.size() == n;
+    for (size_t i = 0; permutation && i < n; i++) {
+        permutation = static_cast<size_t>(order[i]) < n && static_cast<size_t>(position[order[i]]) == i;
+    }
+    check(permutation, "the order is a permutation on " + name);
+    if (!permutation) {
+        return;
+    }
+
+    const graph_type H = relabel(G, order);
+    bool named = true;
+    for (size_t i = 0; i < n; i++) {
+        named = named && H.node_name(i) == order[i];
+    }
+    check(named, "the relabelled nodes are named after their old ids on " + name);
+    check(out_edges(relabel(H, position)) == out_edges(G), "relabelling by the inverse order gives the graph back on " + name);
+
+    // a source that is not the first node, so that the order matters
+    const size_t source = n / 2;
+    bool cycle = false;
+    const std::vector<double> expected = reference_distances(n, edges, source, cycle);
+    std::vector<double> min_distances(n, unreachable);
+    std::vector<node_id_type> predecessor(n, none);
+    dijkstra(H, min_distances, position[source], predecessor);
+    check(to_original_order(H, min_distances) == expected, "the distances translate back on " + name);
+
+    const std::vector<node_id_type> original = to_original_ids(H, predecessor);
+    bool tree = original[source] == static_cast<node_id_type>(source);
+    for (size_t v = 0; v < n; v++) {
+        if (expected[v] == unreachable) {
+            tree = tree && original[v] == none;
+            continue;
+        }
+        if (v == source) {
+            continue;
+        }
+        bool tight = false;
+        for (const auto & edge : G.adjList(original[v])) {
+            tight = tight || (static_cast<size_t>(edge.to) == v && expected[original[v]] + edge.weight == expected[v]);
+        }
+        tree = tree && tight;
+    }
+    check(tree, "the predecessors translate back and keep the marker of unreachable nodes on " + name);
+}
+
+int main()
+{
+    std::mt19937_64 rng(9);
+    const std::vector<std::pair<NodeOrder, std::string>> methods = {{NodeOrder::original, "original"},
+        {NodeOrder::degree, "degree"}, {NodeOrder::bfs, "bfs"}, {NodeOrder::dfs, "dfs"}, {NodeOrder::rcm, "rcm"},
+        {NodeOrder::gorder, "gorder"}};
+    for (unsigned trial = 0; trial < 60; trial++) {
+        const size_t n = 1 + trial % 30;
+        // sparse graphs leave nodes isolated and unreachable
+        const auto edges = random_edges(n, rng() % (2 * n), 0, 50, rng);
+        const auto G = make_graph<double, int>(n, edges);
+        const CSRDigraph<WeightedEdge<double>> csr(G);
+        const auto narrow = make_graph<double, uint8_t>(n, edges);
+        for (auto const & [method, method_name] : methods) {
+            const std::string name = "random graph " + std::to_string(trial) + " in " + method_name + " order";
+            check_relabel(G, method, edges, name);
+            check_relabel(csr, method, edges, name + " on CSR");
+            check_relabel(narrow, method, edges, name + " with uint8_t ids");
+        }
+    }
+    return check_result();
+}
@@ -0,0 +1,85 @@
+// Tests for the point-to-point queries of bidirectional Dijkstra and contraction hierarchies against a plain
+// Bellman-Ford, on random graphs with loops, parallel and zero weight edges, for every pair of nodes, which includes
+// unreachable targets and source == target, and on narrow node ids.
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/bidirectional_dijkstra.h"
+#include "shortest_paths/contraction_hierarchy.h"
+#include "tests/check.h"
+#include "tests/reference.h"
+
+// whether result is a path of G from source to target whose weight is distance, or the empty answer if distance is
+// unreachable
+template<typename graph_type, typename node_id_type>
+bool is_shortest_path(graph_type const & G, ShortestPath<node_id_type> const & result, size_t source, size_t target, double distance)
+{
+    if (distance == unreachable) {
+        return result.distance == unreachable && result.path.empty();
+    }
+    if (result.distance != distance || result.path.empty() || static_cast<size_t>(result.path.front()) != source
+        || static_cast<size_t>(result.path.back()) != target) {
+        return false;
+    }
+    double length = 0;
+    for (size_t i = 0; i + 1 < result.path.size(); i++) {
+        double lightest = unreachable;
+        for (const auto & edge : G.adjList(result.path[i])) {
+            if (edge.to == result.path[i + 1]) {
+                lightest = std::min<double>(lightest, edge.weight);
+            }
+        }
+        if (lightest == unreachable) {
+            return false;
+        }
+        length += lightest;
+    }
+    return length == distance;
+}
+
+template<typename node_id_type>
+void check_queries(size_t n, std::vector<TestEdge> const & edges, size_t witness_limit, std::string const & name)
+{
+    using Graph = Digraph<WeightedEdge<double, node_id_type>>;
+    const Graph G = make_graph<double, node_id_type>(n, edges);
+    BidirectionalDijkstra<Graph> bidirectional(G);
+    const ContractionHierarchy<node_id_type> CH(G, witness_limit);
+    ContractionHierarchyQuery<node_id_type> ch_query(CH);
+    bool bidirectional_right = true;
+    bool ch_right = true;
+    for (size_t source = 0; source < n; source++) {
+        bool cycle = false;
+        const std::vector<double> expected = reference_distances(n, edges, source, cycle);
+        for (size_t target = 0; target < n; target++) {
+            const auto s = static_cast<node_id_type>(source);
+            const auto t = static_cast<node_id_type>(target);
+            bidirectional_right = bidirectional_right && is_shortest_path(G, bidirectional.query(s, t), source, target, expected[target]);
+            ch_right = ch_right && is_shortest_path(G, ch_query.query(s, t), source, target, expected[target]);
+        }
+    }
+    check(bidirectional_right, "bidirectional dijkstra on " + name);
+    check(ch_right, "contraction hierarchy on " + name);
+}
+
+int main()
+{
+    std::mt19937_64 rng(6);
+    for (unsigned trial = 0; trial < 60; trial++) {
+        const size_t n = 1 + trial % 30;
+        const auto edges = random_edges(n, rng() % (4 * n), 0, trial % 2 == 0 ? 5 : 1000, rng);
+        const std::string name = "random graph " + std::to_string(trial);
+        // a witness limit of 1 leaves many unnecessary shortcuts, which must not change any distance
+        check_queries<int>(n, edges, trial % 3 == 0 ? 1 : 500, name);
+        check_queries<uint16_t>(n, edges, 500, name + " with uint16_t ids");
+        check_queries<uint8_t>(n, edges, 500, name + " with uint8_t ids");
+    }
+    check_queries<int>(0, {}, 500, "the empty graph");
+    check_queries<int>(2, {{0, 0, 1}, {1, 1, 0}}, 500, "two nodes with loops only");
+    return check_result();
+}
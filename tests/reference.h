@@ -0,0 +1,79 @@
+// Small random test graphs as plain edge lists, and a Bellman-Ford on them that the tests compare the algorithms to.
+// Author: Georgi Kocharyan
+
+#ifndef TESTS_REFERENCE_H
+#define TESTS_REFERENCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "digraph.h"
+
+constexpr double unreachable = std::numeric_limits<double>::max();
+constexpr int64_t unreachable_int = std::numeric_limits<int64_t>::max();
+
+struct TestEdge
+{
+    size_t from;
+    size_t to;
+    int weight;
+};
+
+// n - 1 rounds over all edges, then one more to see whether a negative cycle is reachable
+inline std::vector<double> reference_distances(size_t n, std::vector<TestEdge> const & edges, size_t source, bool & negative_cycle)
+{
+    std::vector<double> distances(n, unreachable);
+    distances[source] = 0;
+    negative_cycle = false;
+    for (size_t round = 0; round < n; round++) {
+        bool changed = false;
+        for (auto const & edge : edges) {
+            if (distances[edge.from] != unreachable && distances[edge.from] + edge.weight < distances[edge.to]) {
+                distances[edge.to] = distances[edge.from] + edge.weight;
+                changed = true;
+            }
+        }
+        negative_cycle = changed && round + 1 == n;
+    }
+    return distances;
+}
+
+// m edges between random nodes, so loops and parallel edges come up often on few nodes
+inline std::vector<TestEdge> random_edges(size_t n, size_t m, int min_weight, int max_weight, std::mt19937_64 & rng)
+{
+    std::uniform_int_distribution<size_t> node(0, n - 1);
+    std::uniform_int_distribution<int> weight(min_weight, max_weight);
+    std::vector<TestEdge> edges;
+    for (size_t e = 0; e < m; e++) {
+        edges.push_back({node(rng), node(rng), weight(rng)});
+    }
+    return edges;
+}
+
+// adds p[from] - p[to] to every weight for random potentials p, which makes weights negative but leaves the weight of
+// every cycle as it was
+inline void apply_random_potentials(size_t n, std::vector<TestEdge> & edges, std::mt19937_64 & rng)
+{
+    std::vector<int> potential(n);
+    for (auto & p : potential) {
+        p = static_cast<int>(rng() % 30);
+    }
+    for (auto & edge : edges) {
+        edge.weight += potential[edge.from] - potential[edge.to];
+    }
+}
+
+template<typename weight_type, typename node_id_type>
+Digraph<WeightedEdge<weight_type, node_id_type>> make_graph(size_t n, std::vector<TestEdge> const & edges)
+{
+    Digraph<WeightedEdge<weight_type, node_id_type>> G(n);
+    for (auto const & edge : edges) {
+        G.add_edge(static_cast<node_id_type>(edge.from), static_cast<node_id_type>(edge.to), static_cast<weight_type>(edge.weight));
+    }
+    return G;
+}
+
+#endif //TESTS_REFERENCE_H
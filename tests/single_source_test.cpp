@@ -0,0 +1,211 @@
+// Tests for the single source shortest path algorithms: dijkstra on both graph types and with every queue, delta
+// stepping, Moore-Bellman-Ford, spfa and the parallel Moore-Bellman-Ford against a plain Bellman-Ford on small random
+// graphs with loops, parallel edges, zero weights and unreachable nodes, on narrow node ids, and with negative cycles.
+// Author: Georgi Kocharyan
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "digraph.h"
+#include "shortest_paths/delta_stepping.h"
+#include "shortest_paths/dijkstra.h"
+#include "shortest_paths/dijkstra_auto.h"
+#include "shortest_paths/dijkstra_dial.h"
+#include "shortest_paths/dijkstra_radix.h"
+#include "shortest_paths/moore_bellman_ford.h"
+#include "shortest_paths/parallel_bellman_ford.h"
+#include "tests/check.h"
+#include "tests/reference.h"
+
+// whether predecessor is a shortest path tree for min_distances: every reached node other than the source has an edge
+// from its predecessor that is tight
+template<typename graph_type, typename distance_type>
+bool is_tree(graph_type const & G, std::vector<distance_type> const & min_distances, typename graph_type::node_id_type source,
+    std::vector<typename graph_type::node_id_type> const & predecessor)
+{
+    if (predecessor[source] != source) {
+        return false;
+    }
+    for (size_t v = 0; v < G.num_nodes(); v++) {
+        if (v == static_cast<size_t>(source) || min_distances[v] == std::numeric_limits<distance_type>::max()) {
+            continue;
+        }
+        bool tight = false;
+        for (const auto & edge : G.adjList(predecessor[v])) {
+            tight = tight || (static_cast<size_t>(edge.to) == v && min_distances[predecessor[v]] + edge.weight == min_distances[v]);
+        }
+        if (!tight) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename distance_type>
+bool same_distances(std::vector<distance_type> const & computed, std::vector<double> const & expected)
+{
+    for (size_t v = 0; v < expected.size(); v++) {
+        const bool reached = computed[v] != std::numeric_limits<distance_type>::max();
+        if (reached != (expected[v] != unreachable) || (reached && static_cast<double>(computed[v]) != expected[v])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// every algorithm from source on a graph with nonnegative weights
+template<typename node_id_type>
+void check_nonnegative(size_t n, std::vector<TestEdge> const & edges, size_t source, std::string const & name)
+{
+    bool negative_cycle = false;
+    const std::vector<double> expected = reference_distances(n, edges, source, negative_cycle);
+    const auto G = make_graph<double, node_id_type>(n, edges);
+    const auto integral = make_graph<int, node_id_type>(n, edges);
+    const CSRDigraph<WeightedEdge<double, node_id_type>> csr(G);
+    const node_id_type s = static_cast<node_id_type>(source);
+
+    auto run_double = [&](std::string const & algorithm, auto const & graph, auto && search) {
+        std::vector<double> min_distances(n, unreachable);
+        std::vector<node_id_type> predecessor(n);
+        search(graph, min_distances, predecessor);
+        check(same_distances(min_distances, expected), algorithm + " distances on " + name);
+        check(is_tree(graph, min_distances, s, predecessor), algorithm + " tree on " + name);
+    };
+    run_double("dijkstra", G, [&](auto const & graph, auto & d, auto & p) { dijkstra(graph, d, s, p); });
+    run_double("dijkstra on CSR", csr, [&](auto const & graph, auto & d, auto & p) { dijkstra(graph, d, s, p); });
+    run_double("binary heap dijkstra", G, [&](auto const & graph, auto & d, auto & p) { dijkstra<2>(graph, d, s, p); });
+    run_double("delta stepping", G, [&](auto const & graph, auto & d, auto & p) { delta_stepping(graph, d, s, p, 0, 1); });
+    run_double("delta stepping on 3 threads", csr, [&](auto const & graph, auto & d, auto & p) { delta_stepping(graph, d, s, p, 2.5, 3); });
+    run_double("spfa", G, [&](auto const & graph, auto & d, auto & p) { check(spfa(graph, d, s, p).empty(), "spfa finds no cycle on " + name); });
+    run_double("parallel bellman-ford", csr, [&](auto const & graph, auto & d, auto & p) {
+        bool cycle = false;
+        parallel_moore_bellman_ford(graph, d, s, p, cycle, 2);
+        check(!cycle, "parallel bellman-ford finds no cycle on " + name);
+    });
+
+    std::vector<double> min_distances(n, unreachable);
+    bool cycle = false;
+    moore_bellman_ford(G, min_distances, s, cycle);
+    check(!cycle && same_distances(min_distances, expected), "moore-bellman-ford distances on " + name);
+
+    auto run_integral = [&](std::string const & algorithm, auto && search) {
+        std::vector<int64_t> distances(n, unreachable_int);
+        std::vector<node_id_type> predecessor(n);
+        search(distances, predecessor);
+        check(same_distances(distances, expected), algorithm + " distances on " + name);
+        check(is_tree(integral, distances, s, predecessor), algorithm + " tree on " + name);
+    };
+    run_integral("radix heap dijkstra", [&](auto & d, auto & p) { dijkstra_radix(integral, d, s, p); });
+    run_integral("dial", [&](auto & d, auto & p) { dijkstra_dial(integral, d, s, p); });
+    run_integral("dijkstra_auto", [&](auto & d, auto & p) { dijkstra_auto(integral, d, s, p); });
+}
+
+void test_nonnegative()
+{
+    std::mt19937_64 rng(1);
+    for (unsigned trial = 0; trial < 60; trial++) {
+        const size_t n = 1 + trial % 30;
+        // zero weights, loops and parallel edges are all likely on few nodes, and sparse graphs leave nodes unreachable
+        const auto edges = random_edges(n, rng() % (3 * n), 0, trial % 2 == 0 ? 9 : 1000, rng);
+        const size_t source = rng() % n;
+        const std::string name = "random graph " + std::to_string(trial);
+        check_nonnegative<int>(n, edges, source, name);
+        check_nonnegative<uint16_t>(n, edges, source, name + " with uint16_t ids");
+        check_nonnegative<uint8_t>(n, edges, source, name + " with uint8_t ids");
+    }
+    check_nonnegative<int>(1, {}, 0, "a single node");
+    check_nonnegative<int>(1, {{0, 0, 3}}, 0, "a single node with a loop");
+    check_nonnegative<int>(4, {{1, 2, 1}, {2, 3, 1}}, 0, "a source without out-edges");
+}
+
+// the nodes of a cycle in the order of its edges, with the lightest edge between consecutive nodes
+bool is_negative_cycle(std::vector<TestEdge> const & edges, std::vector<int> const & cycle)
+{
+    if (cycle.empty()) {
+        return false;
+    }
+    double total = 0;
+    for (size_t i = 0; i < cycle.size(); i++) {
+        const size_t from = cycle[i];
+        const size_t to = cycle[(i + 1) % cycle.size()];
+        double lightest = unreachable;
+        for (auto const & edge : edges) {
+            if (edge.from == from && edge.to == to) {
+                lightest = std::min<double>(lightest, edge.weight);
+            }
+        }
+        if (lightest == unreachable) {
+            return false;
+        }
+        total += lightest;
+    }
+    return total < 0;
+}
+
+void test_negative_weights()
+{
+    std::mt19937_64 rng(2);
+    for (unsigned trial = 0; trial < 200; trial++) {
+        const size_t n = 2 + trial % 20;
+        // potentials keep cycles nonnegative in half of the trials, the others may well have negative cycles
+        std::vector<TestEdge> edges = random_edges(n, rng() % (3 * n), 0, 20, rng);
+        if (trial % 2 == 0) {
+            apply_random_potentials(n, edges, rng);
+        }
+        else {
+            for (auto & edge : edges) {
+                edge.weight -= 5;
+            }
+        }
+        const size_t source = rng() % n;
+        const std::string name = "random graph with negative weights " + std::to_string(trial);
+        bool expected_cycle = false;
+        const std::vector<double> expected = reference_distances(n, edges, source, expected_cycle);
+        const auto G = make_graph<double, int>(n, edges);
+        const int s = static_cast<int>(source);
+
+        std::vector<double> min_distances(n, unreachable);
+        bool cycle = false;
+        moore_bellman_ford(G, min_distances, s, cycle);
+        check(cycle == expected_cycle && (cycle || same_distances(min_distances, expected)), "moore-bellman-ford on " + name);
+
+        min_distances.assign(n, unreachable);
+        std::vector<int> predecessor(n);
+        const std::vector<int> negative = spfa(G, min_distances, s, predecessor);
+        check(negative.empty() != expected_cycle, "spfa detects the negative cycle on " + name);
+        check(negative.empty() || is_negative_cycle(edges, negative), "spfa returns a negative cycle on " + name);
+        check(!negative.empty() || (same_distances(min_distances, expected) && is_tree(G, min_distances, s, predecessor)),
+            "spfa distances on " + name);
+
+        for (const unsigned threads : {1u, 3u}) {
+            min_distances.assign(n, unreachable);
+            cycle = false;
+            parallel_moore_bellman_ford(G, min_distances, s, predecessor, cycle, threads);
+            check(cycle == expected_cycle && (cycle || same_distances(min_distances, expected)),
+                "parallel bellman-ford on " + std::to_string(threads) + " threads on " + name);
+        }
+    }
+
+    // a negative cycle the source cannot reach is no concern of its distances
+    const std::vector<TestEdge> edges = {{0, 1, 2}, {2, 3, -4}, {3, 2, 1}};
+    bool expected_cycle = false;
+    const std::vector<double> expected = reference_distances(4, edges, 0, expected_cycle);
+    const auto G = make_graph<double, int>(4, edges);
+    std::vector<double> min_distances(4, unreachable);
+    bool cycle = false;
+    moore_bellman_ford(G, min_distances, 0, cycle);
+    check(!cycle && same_distances(min_distances, expected), "moore-bellman-ford with an unreachable negative cycle");
+    min_distances.assign(4, unreachable);
+    std::vector<int> predecessor(4);
+    check(spfa(G, min_distances, 0, predecessor).empty() && same_distances(min_distances, expected), "spfa with an unreachable negative cycle");
+}
+
+int main()
+{
+    test_nonnegative();
+    test_negative_weights();
+    return check_result();
+}
@@ -10,15 +10,17 @@
 
 using UnweightedDigraph = Digraph<Edge>;
 
-void top_order(const UnweightedDigraph & G)
+template<IsDigraph graph_type>
+void top_order(const graph_type & G)
 {
+    using node_id_type = typename graph_type::node_id_type;
     // keeps track of vertices with zero indegree, these can be put at the beginning
-    std::stack<int> zero_indegree;
+    std::stack<node_id_type> zero_indegree;
 
-    std::vector<int> indegs = G.indegrees();
-    int amount = 0;
+    auto indegs = G.indegrees();
+    size_t amount = 0;
 
-    for (int i = 0; i < G.num_nodes(); i++) {
+    for (node_id_type i = 0; i < G.num_nodes(); i++) {
         if (indegs[i] == 0) {
             zero_indegree.push(i);
             amount++;
@@ -26,10 +28,10 @@ void top_order(const UnweightedDigraph & G)
     }
     // update indegs, zero_indegree after adding a vertex to the top. order
     while (!zero_indegree.empty()) {
-        const int node_id = zero_indegree.top();
+        const node_id_type node_id = zero_indegree.top();
         zero_indegree.pop();
         std::cout << node_id << ' ';
-        for (auto i: G.adjList(node_id)) {
+        for (const auto & i: G.adjList(node_id)) {
             if (indegs[i.to] == 1) // this ensures each vertex added to stack only once
             {
                 zero_indegree.push(i.to);